@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace col::bench {
+
+    // グローバルな `operator new` が呼び出された回数。
+    // bench_allocation.cpp の置換された `operator new` が数える。
+    extern std::size_t allocation_count;
+
+    // 値 `value` の計算が最適化によって取り除かれないようにする。
+    template <class T>
+    inline void do_not_optimize(const T& value) noexcept
+    {
+        static volatile const void* sink = nullptr;
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    // このスレッドが実行したユーザー空間の命令数を数える。
+    // perf_event_open(2) が利用できない環境では計測できず、 `read()` は常に `std::nullopt` を返す。
+    class InstructionCounter
+    {
+        int m_fd;
+    public:
+        InstructionCounter() noexcept
+        : m_fd{ -1 }
+        {
+#if defined(__linux__)
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            m_fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0UL));
+#endif
+        }
+
+        InstructionCounter(const InstructionCounter&) = delete;
+        InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+        ~InstructionCounter()
+        {
+#if defined(__linux__)
+            if( m_fd >= 0 )
+            {
+                ::close(m_fd);
+            }
+#endif
+        }
+
+        // 計測できる環境であれば `true` 。
+        [[nodiscard]] bool available() const noexcept
+        {
+            return m_fd >= 0;
+        }
+
+        // 計数を 0 にして計測を始める。
+        void start() noexcept
+        {
+#if defined(__linux__)
+            if( m_fd >= 0 )
+            {
+                ::ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        // 計測を止めて、 `start()` からの命令数を得る。
+        [[nodiscard]] std::optional<std::uint64_t> stop() noexcept
+        {
+#if defined(__linux__)
+            if( m_fd >= 0 )
+            {
+                ::ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+                std::uint64_t count = 0;
+                if( ::read(m_fd, &count, sizeof(count)) == static_cast<::ssize_t>(sizeof(count)) )
+                {
+                    return count;
+                }
+            }
+#endif
+            return std::nullopt;
+        }
+    };
+
+    // ひとつのベンチマークケースの計測結果。
+    struct Result
+    {
+        // 計測した反復の回数。
+        std::size_t iterations;
+        // 1 反復あたりのトークン数。
+        std::size_t tokens_per_iteration;
+        // 1 トークンあたりの経過時間(ナノ秒)。
+        double ns_per_token;
+        // 1 反復あたりの `operator new` の呼び出し回数。
+        double allocations_per_iteration;
+        // 1 トークンあたりの命令数。計測できない環境では `std::nullopt` 。
+        std::optional<double> instructions_per_token;
+    };
+
+    // ベンチマークの設定。
+    struct Config
+    {
+        // 計測に費やす最小の時間。
+        std::chrono::nanoseconds min_duration = std::chrono::milliseconds{ 200 };
+        // 計測前に捨てる反復の回数。
+        std::size_t warmup_iterations = 16ZU;
+    };
+
+    // `fn` を繰り返し呼び出して計測する。 `fn` は 1 回の呼び出しで `tokens_per_iteration` 個のトークンを処理する。
+    //
+    // 反復回数は `config.min_duration` を超えるまで倍々に増やして決める。
+    // 命令数とアロケーション回数は、決まった反復回数をもう一度実行して計測する。
+    template <class F>
+    [[nodiscard]] Result measure(std::size_t tokens_per_iteration, F&& fn, const Config& config = {})
+    {
+        using clock = std::chrono::steady_clock;
+
+        for( std::size_t i = 0ZU; i < config.warmup_iterations; ++i )
+        {
+            fn();
+        }
+
+        std::size_t iterations = 1ZU;
+        clock::duration elapsed{};
+        while( true )
+        {
+            const auto begin = clock::now();
+            for( std::size_t i = 0ZU; i < iterations; ++i )
+            {
+                fn();
+            }
+            elapsed = clock::now() - begin;
+            if( elapsed >= config.min_duration )
+            {
+                break;
+            }
+            iterations *= 2ZU;
+        }
+
+        InstructionCounter counter{};
+        const auto allocations_before = allocation_count;
+        counter.start();
+        for( std::size_t i = 0ZU; i < iterations; ++i )
+        {
+            fn();
+        }
+        const auto instructions = counter.stop();
+        const auto allocations = allocation_count - allocations_before;
+
+        const auto tokens = static_cast<double>(iterations * (tokens_per_iteration == 0ZU ? 1ZU : tokens_per_iteration));
+        return Result{
+            .iterations = iterations,
+            .tokens_per_iteration = tokens_per_iteration,
+            .ns_per_token = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / tokens,
+            .allocations_per_iteration = static_cast<double>(allocations) / static_cast<double>(iterations),
+            .instructions_per_token = instructions.transform([tokens](std::uint64_t count) noexcept
+                {
+                    return static_cast<double>(count) / tokens;
+                }),
+        };
+    }
+
+    // 計測結果を 1 行の JSON として `out` に書き込み、読みやすい形式で `stderr` にも表示する。
+    //
+    // `name` はケースの名前、 `param_name` と `param` はケースを区別するパラメータ。
+    inline void report(std::FILE* out, std::string_view name, std::string_view param_name, std::size_t param, const Result& result)
+    {
+        const auto name_length = static_cast<int>(name.size());
+        const auto param_name_length = static_cast<int>(param_name.size());
+        std::fprintf(out,
+            "{\"name\":\"%.*s\",\"%.*s\":%zu,\"iterations\":%zu,\"tokens_per_iteration\":%zu,"
+            "\"ns_per_token\":%.3f,\"allocations_per_iteration\":%.3f,\"instructions_per_token\":",
+            name_length, name.data(), param_name_length, param_name.data(), param,
+            result.iterations, result.tokens_per_iteration,
+            result.ns_per_token, result.allocations_per_iteration);
+        if( result.instructions_per_token.has_value() )
+        {
+            std::fprintf(out, "%.3f}\n", *result.instructions_per_token);
+        }
+        else
+        {
+            std::fputs("null}\n", out);
+        }
+
+        std::fprintf(stderr, "%-32.*s %.*s=%-6zu %10.3f ns/token %8.3f alloc/iter",
+            name_length, name.data(), param_name_length, param_name.data(), param,
+            result.ns_per_token, result.allocations_per_iteration);
+        if( result.instructions_per_token.has_value() )
+        {
+            std::fprintf(stderr, " %10.3f inst/token\n", *result.instructions_per_token);
+        }
+        else
+        {
+            std::fputs("          - inst/token\n", stderr);
+        }
+    }
+
+    // コマンドライン引数で出力先のファイルが指定されていればそれを開き、なければ `stdout` を返す。
+    [[nodiscard]] inline std::FILE* open_output(int argc, char** argv)
+    {
+        if( argc >= 2 )
+        {
+            if( std::FILE* file = std::fopen(argv[1], "w") )
+            {
+                return file;
+            }
+            std::fprintf(stderr, "cannot open %s, writing to stdout\n", argv[1]);
+        }
+        return stdout;
+    }
+
+} // namespace col::bench
@@ -0,0 +1,32 @@
+#include "bench.h"
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <new>
+
+namespace col::bench {
+
+    constinit std::size_t allocation_count = 0ZU;
+
+} // namespace col::bench
+
+void* operator new(std::size_t size)
+{
+    ++col::bench::allocation_count;
+    if( void* p = std::malloc(size == 0ZU ? 1ZU : size) )
+    {
+        return p;
+    }
+    std::abort();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,60 @@
+// コンパイル時間のベンチマークで、コンパイルされる翻訳単位。
+// compile_bench.sh が `COL_BENCH_OPTIONS` と `COL_BENCH_DEPTH` を変えながら繰り返しコンパイルする。
+//
+// ルートのコマンドに `int` のオプションを `COL_BENCH_OPTIONS` 個と、
+// `COL_BENCH_DEPTH` 段のサブコマンドの入れ子を持つコマンドを合成し、そのパースを実体化する。
+
+#include "synthesized_command.h"
+
+#include <col/command.h>
+
+#include <cstddef>
+
+#include <array>
+#include <concepts>
+#include <expected>
+#include <span>
+#include <utility>
+#include <variant>
+
+#ifndef COL_BENCH_OPTIONS
+#define COL_BENCH_OPTIONS 10
+#endif
+
+#ifndef COL_BENCH_DEPTH
+#define COL_BENCH_DEPTH 1
+#endif
+
+namespace col::bench {
+
+    inline constexpr std::size_t Options = COL_BENCH_OPTIONS;
+    inline constexpr std::size_t Depth = COL_BENCH_DEPTH;
+    static_assert(Depth >= 1ZU && Depth < col::MaxCommandDepth);
+
+    // 合成されたコマンドのパース結果。
+    struct CompileBenchTarget
+    {
+        std::variant<std::monostate, NestedTarget<Depth>> sub;
+        int value;
+        std::array<int, Options> values;
+
+        template <class ...Ts>
+        requires (sizeof...(Ts) == Options && (std::same_as<Ts, int> && ...))
+        constexpr CompileBenchTarget(std::variant<std::monostate, NestedTarget<Depth>> s, int v, Ts ...ts) noexcept
+        : sub{ std::move(s) }
+        , value{ v }
+        , values{ ts... }
+        {}
+    };
+
+    // 合成されたコマンドで `args` をパースする。
+    // 外部リンケージを持たせ、パースの実体化がオブジェクトファイルに残るようにする。
+    std::expected<CompileBenchTarget, col::ParseError> parse_synthesized(std::span<const char* const> args);
+
+    std::expected<CompileBenchTarget, col::ParseError> parse_synthesized(std::span<const char* const> args)
+    {
+        static const auto cmd = add_int_options<0ZU, Options>(make_nested_cmd<Depth + 1ZU>());
+        return cmd.parse<CompileBenchTarget>(args);
+    }
+
+} // namespace col::bench
@@ -0,0 +1,68 @@
+#!/bin/sh
+# コマンドビルダーのテンプレートのコンパイルコストを計測する。
+#
+# compile_bench.cpp をオプション数 N とサブコマンドの深さ D を変えながらコンパイルし、
+# clang の -ftime-trace の集計値、テンプレートの実体化の回数、オブジェクトファイルのサイズを
+# 1 組ごとに 1 行の JSON として出力する。
+#
+# 使い方: compile_bench.sh [出力ファイル]
+# 環境変数:
+#   CXX      コンパイラ (既定値: clang++-22)
+#   OPTIONS  計測するオプション数の列 (既定値: "10 25 50 100 150 250 500")
+#   DEPTHS   計測するサブコマンドの深さの列 (既定値: "1 2 3 4 5 6")
+#   SIZE     セクションサイズを得るコマンド (既定値: size)
+
+set -eu
+
+CXX="${CXX:-clang++-22}"
+OPTIONS="${OPTIONS:-10 25 50 100 150 250 500}"
+DEPTHS="${DEPTHS:-1 2 3 4 5 6}"
+SIZE="${SIZE:-size}"
+
+ROOT="$(cd "$(dirname "$0")/../../.." && pwd)"
+WORK="${ROOT}/build/col/bench/compile"
+OUT="${1:-/dev/stdout}"
+
+mkdir -p "${WORK}"
+: > "${OUT}"
+
+# time trace のファイル $1 から、イベント "Total $2" の値 $3 ("dur" または "count") を得る。
+# 見つからなければ 0 。
+trace_total() {
+    value="$(grep -o "\"dur\":[0-9]*,\"name\":\"Total $2\",\"args\":{\"count\":[0-9]*" "$1" \
+        | sed -n "s/.*\"$3\":\\([0-9]*\\).*/\\1/p" | head -n 1)"
+    echo "${value:-0}"
+}
+
+for depth in ${DEPTHS}; do
+    for options in ${OPTIONS}; do
+        base="${WORK}/compile_bench_n${options}_d${depth}"
+        rm -f "${base}.o" "${base}.json"
+
+        # 実行ファイルのコンパイル時間とそろえるため、リポジトリのコンパイルフラグをそのまま使う。
+        (cd "${ROOT}" && "${CXX}" @compile_flags.txt -O2 -ftime-trace -ftime-trace-granularity=0 \
+            -DCOL_BENCH_OPTIONS="${options}" -DCOL_BENCH_DEPTH="${depth}" \
+            -c ./benchmarks/col/command/compile_bench.cpp -o "${base}.o")
+
+        # -ftime-trace はオブジェクトファイルと同じ名前で拡張子 .json のファイルを出力する。
+        trace="${base}.json"
+        total_us="$(trace_total "${trace}" ExecuteCompiler dur)"
+        frontend_us="$(trace_total "${trace}" Frontend dur)"
+        backend_us="$(trace_total "${trace}" Backend dur)"
+        class_us="$(trace_total "${trace}" InstantiateClass dur)"
+        class_count="$(trace_total "${trace}" InstantiateClass count)"
+        function_us="$(trace_total "${trace}" InstantiateFunction dur)"
+        function_count="$(trace_total "${trace}" InstantiateFunction count)"
+
+        object_bytes="$(wc -c < "${base}.o" | tr -d ' ')"
+        text_bytes="$("${SIZE}" "${base}.o" 2>/dev/null | awk 'NR == 2 { print $1 }')"
+
+        line="$(printf '{"options":%s,"depth":%s,"total_us":%s,"frontend_us":%s,"backend_us":%s,"instantiate_class_us":%s,"instantiate_class_count":%s,"instantiate_function_us":%s,"instantiate_function_count":%s,"object_bytes":%s,"text_bytes":%s}' \
+            "${options}" "${depth}" "${total_us}" "${frontend_us}" "${backend_us}" \
+            "${class_us}" "${class_count}" "${function_us}" "${function_count}" \
+            "${object_bytes}" "${text_bytes:-null}")"
+        echo "${line}" >> "${OUT}"
+        printf 'options=%-4s depth=%s total=%8s us  class=%6s  function=%6s  object=%8s bytes\n' \
+            "${options}" "${depth}" "${total_us}" "${class_count}" "${function_count}" "${object_bytes}" >&2
+    done
+done
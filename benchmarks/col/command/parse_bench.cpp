@@ -0,0 +1,359 @@
+#include "../bench.h"
+#include "synthesized_command.h"
+
+#include <col/command.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+namespace {
+
+    // `int` のオプションを `N` 個持つコマンドのパース。
+    template <std::size_t N>
+    void bench_flat_options(std::FILE* out)
+    {
+        static const auto cmd = col::bench::make_flat_cmd<N>();
+        const auto args = col::bench::make_flat_args<N>();
+        const auto argv = col::bench::to_argv(args);
+
+        if( !cmd.template parse<col::bench::FlatTarget<N>>(std::span{ argv }).has_value() )
+        {
+            std::fprintf(stderr, "parse/options: unexpected parse failure (options = %zu)\n", N);
+            std::exit(EXIT_FAILURE);
+        }
+
+        const auto result = col::bench::measure(argv.size(), [&]
+            {
+                const auto res = cmd.template parse<col::bench::FlatTarget<N>>(std::span{ argv });
+                col::bench::do_not_optimize(res);
+            });
+        col::bench::report(out, "parse/options", "options", N, result);
+    }
+
+    // ルートを含めて `Depth` 段のサブコマンドを辿るパース。
+    template <std::size_t Depth>
+    void bench_nested_subcommands(std::FILE* out)
+    {
+        static const auto cmd = col::bench::make_nested_cmd<Depth>();
+        const auto args = col::bench::make_nested_args<Depth>();
+        const auto argv = col::bench::to_argv(args);
+
+        if( !cmd.template parse<col::bench::NestedTarget<Depth>>(std::span{ argv }).has_value() )
+        {
+            std::fprintf(stderr, "parse/subcommands: unexpected parse failure (depth = %zu)\n", Depth);
+            std::exit(EXIT_FAILURE);
+        }
+
+        const auto result = col::bench::measure(argv.size(), [&]
+            {
+                const auto res = cmd.template parse<col::bench::NestedTarget<Depth>>(std::span{ argv });
+                col::bench::do_not_optimize(res);
+            });
+        col::bench::report(out, "parse/subcommands", "depth", Depth, result);
+    }
+
+    // ベースラインの `col::ParseError` 。
+    // `ShowHelp` はヘルプメッセージを `std::string` で、 `UnknownOption` はトークンだけを持っていた。
+    // 他の型は今と同じ定義のため、そのまま用いる。
+    namespace baseline {
+        struct ShowHelp
+        {
+            std::string help_message;
+        };
+        struct UnknownOption
+        {
+            std::string_view arg;
+        };
+        using ParseError =
+            std::variant<
+                col::UnknownError,
+                col::InternalLogicError,
+                UnknownOption,
+                ShowHelp,
+                col::DuplicateOption,
+                col::MissingOptionValue,
+                col::ValueParserError,
+                col::DefaultValueError,
+                col::InvalidNumber,
+                col::NotEnoughArgument,
+                col::InvalidConfiguration,
+                col::MissingRequiredOption
+            >;
+    } // namespace baseline
+
+    // `propagate` が引数の不足で失敗したときのエラー。
+    template <class Error>
+    Error not_enough_argument()
+    {
+        if constexpr( std::same_as<Error, col::ParseError> )
+        {
+            return col::ParseError{ col::ParseErrorKind::NotEnoughArgument };
+        }
+        else
+        {
+            return Error{ col::NotEnoughArgument{} };
+        }
+    }
+
+    // `argv` のトークンを 1 段に 1 つずつ読み、 `Level` 段の呼び出しを経て各トークンの長さの和を返す。
+    // 各段はサブコマンドの `parse_impl` と同じく、下の段が返した `std::expected` を受け取って返し直す。
+    // 成功しても `std::expected<std::size_t, Error>` の大きさの分だけ戻り値の領域を確保してやり取りするため、
+    // `Error` の大きさとコピーの可否による成功時の負荷の違いを比べられる。
+    template <class Error, std::size_t Level>
+    [[gnu::noinline]] std::expected<std::size_t, Error> propagate(const char* const* argv)
+    {
+        if( *argv == nullptr )
+        {
+            return std::unexpected{ not_enough_argument<Error>() };
+        }
+        const auto length = std::string_view{ *argv }.size();
+        if constexpr( Level == 1ZU )
+        {
+            return length;
+        }
+        else
+        {
+            auto res = propagate<Error, Level - 1ZU>(argv + 1);
+            if( !res.has_value() )
+            {
+                return std::unexpected{ std::move(res).error() };
+            }
+            return *res + length;
+        }
+    }
+
+    // 成功時にエラー型が負荷になるかを調べる。
+    //
+    // `Depth` 段のサブコマンドを辿るパースを、 `std::expected<T, col::ParseError>` の大きさとともに記録する。
+    // また、 `propagate` で成功の結果を `Depth` 段返し直す時間を、次の 3 つのエラー型で比べ、それぞれの大きさとともに記録する。
+    //
+    // - `col::ParseError` : 16 バイトのトリビアルにコピーできる値。
+    // - `col::ParseErrorDetail` : `col::ParseError` が各エラーの構造体の `std::variant` だった頃と同じ型。
+    // - `baseline::ParseError` : ベースラインの `col::ParseError` 。トリビアルにコピーできない。
+    template <std::size_t Depth>
+    void bench_error_size(std::FILE* out)
+    {
+        using Target = col::bench::NestedTarget<Depth>;
+        static const auto cmd = col::bench::make_nested_cmd<Depth>();
+        const auto args = col::bench::make_nested_args<Depth>();
+        const auto argv = col::bench::to_argv(args);
+
+        const auto parse_result = col::bench::measure(argv.size(), [&]
+            {
+                const auto res = cmd.template parse<Target>(std::span{ argv });
+                col::bench::do_not_optimize(res);
+            });
+        col::bench::report(out, "error_size/parse_expected", "expected_bytes", sizeof(std::expected<Target, col::ParseError>), parse_result);
+
+        auto chain = argv;
+        chain.push_back(nullptr);
+        const auto bench_propagate = [&]<class Error>(std::string_view name)
+            {
+                const auto result = col::bench::measure(Depth, [&]
+                    {
+                        const auto res = propagate<Error, Depth>(chain.data());
+                        col::bench::do_not_optimize(res);
+                    });
+                col::bench::report(out, name, "error_bytes", sizeof(Error), result);
+            };
+        bench_propagate.template operator()<col::ParseError>("error_size/return_record");
+        bench_propagate.template operator()<col::ParseErrorDetail>("error_size/return_variant");
+        bench_propagate.template operator()<baseline::ParseError>("error_size/return_baseline");
+    }
+
+    // `Tokens` 個のトークンからなる argv のパース。
+    // 同じオプションは 1 度しか指定できないため、 16 個のオプションを持つコマンドの引数を繰り返し並べ、
+    // イテレータを進めながら 1 コマンド分ずつパースする。
+    template <std::size_t Tokens>
+    void bench_long_argv(std::FILE* out)
+    {
+        constexpr std::size_t Options = 16ZU;
+        static const auto cmd = col::bench::make_flat_cmd<Options>();
+        const auto chunk = col::bench::make_flat_args<Options>();
+        std::vector<std::string> args{};
+        args.reserve(Tokens);
+        while( args.size() + chunk.size() <= Tokens )
+        {
+            args.insert(args.end(), chunk.begin(), chunk.end());
+        }
+        const auto argv = col::bench::to_argv(args);
+
+        const auto result = col::bench::measure(argv.size(), [&]
+            {
+                for( auto iter = argv.cbegin(); iter != argv.cend(); )
+                {
+                    const auto end = iter + static_cast<std::ptrdiff_t>(chunk.size());
+                    const auto res = cmd.template parse<col::bench::FlatTarget<Options>>(std::span{ iter, end });
+                    col::bench::do_not_optimize(res);
+                    iter = end;
+                }
+            });
+        col::bench::report(out, "parse/argv", "tokens", argv.size(), result);
+    }
+
+    // 短いオプションのまとまり `-xvfq` と値の続く `-n5` のパース、および同じ指定を長い名前で与えたパース。
+    void bench_short_options(std::FILE* out)
+    {
+        struct Target
+        {
+            bool extract;
+            bool verbose;
+            bool force;
+            bool quiet;
+            int num;
+        };
+        static constexpr auto cmd = col::Cmd{"bench", "short options"}
+            .add(col::Arg{"extract", "extract"}.set_short_name('x'))
+            .add(col::Arg{"verbose", "verbose"}.set_short_name('v'))
+            .add(col::Arg{"force", "force"}.set_short_name('f'))
+            .add(col::Arg{"quiet", "quiet"}.set_short_name('q'))
+            .add(col::Arg<int>{"num", "num"}.set_short_name('n'));
+        const std::array<const char*, 2> short_argv{ "-xvfq", "-n5" };
+        const std::array<const char*, 6> long_argv{ "--extract", "--verbose", "--force", "--quiet", "--num", "5" };
+
+        if( !cmd.parse<Target>(std::span{ short_argv }).has_value() || !cmd.parse<Target>(std::span{ long_argv }).has_value() )
+        {
+            std::fputs("parse/short_options: unexpected parse failure\n", stderr);
+            std::exit(EXIT_FAILURE);
+        }
+
+        const auto short_result = col::bench::measure(short_argv.size(), [&]
+            {
+                const auto res = cmd.parse<Target>(std::span{ short_argv });
+                col::bench::do_not_optimize(res);
+            });
+        col::bench::report(out, "parse/short_options", "tokens", short_argv.size(), short_result);
+        const auto long_result = col::bench::measure(long_argv.size(), [&]
+            {
+                const auto res = cmd.parse<Target>(std::span{ long_argv });
+                col::bench::do_not_optimize(res);
+            });
+        col::bench::report(out, "parse/long_options", "tokens", long_argv.size(), long_result);
+    }
+
+    // `Elements` 個の数値をカンマで区切った 1 つの値を `Arg<std::vector<std::uint64_t>>` としてパースする。
+    template <std::size_t Elements>
+    void bench_number_list(std::FILE* out)
+    {
+        static const auto cmd = col::Cmd{"bench", "number list"}
+            .add(col::Arg<std::vector<std::uint64_t>>{"ids", "ids"});
+        std::string ids{};
+        for( std::size_t i = 0ZU; i < Elements; ++i )
+        {
+            if( i != 0ZU )
+            {
+                ids += ',';
+            }
+            ids += std::to_string(i * 2654435761ZU);
+        }
+        const std::array<const char*, 2> argv{ "--ids", ids.c_str() };
+
+        if( !cmd.template parse<std::vector<std::uint64_t>>(std::span{ argv }).has_value() )
+        {
+            std::fprintf(stderr, "parse/number_list: unexpected parse failure (elements = %zu)\n", Elements);
+            std::exit(EXIT_FAILURE);
+        }
+
+        const auto result = col::bench::measure(Elements, [&]
+            {
+                const auto res = cmd.template parse<std::vector<std::uint64_t>>(std::span{ argv });
+                col::bench::do_not_optimize(res);
+            });
+        col::bench::report(out, "parse/number_list", "elements", Elements, result);
+    }
+
+    // `Candidates` 個の候補からの選択。
+    // 線形に走査する `col::PossibleValueParser` と、ハッシュテーブルを引く `col::PossibleValueSet` を比較する。
+    // 最後の候補と一致する文字列、およびどの候補とも一致しない文字列を交互に与える。
+    template <std::size_t Candidates>
+    void bench_possible_values(std::FILE* out)
+    {
+        std::vector<std::string> storage{};
+        storage.reserve(Candidates);
+        for( std::size_t i = 0ZU; i < Candidates; ++i )
+        {
+            storage.push_back("candidate-" + std::to_string(i));
+        }
+        std::array<std::string_view, Candidates> candidates{};
+        std::ranges::copy(storage, candidates.begin());
+        const col::PossibleValueParser<std::string_view> linear( candidates );
+        // 候補が多いとスタックに置くには大きいため、ヒープに置く
+        const auto hashed = std::make_unique<const col::PossibleValueSet<std::string_view, Candidates>>(candidates);
+
+        const std::string_view hit = storage.back();
+        const std::string_view miss = "candidate-none";
+
+        const auto linear_result = col::bench::measure(2ZU, [&]
+            {
+                const auto hit_res = linear(hit);
+                col::bench::do_not_optimize(hit_res);
+                const auto miss_res = linear(miss);
+                col::bench::do_not_optimize(miss_res);
+            });
+        col::bench::report(out, "possible_values/linear", "candidates", Candidates, linear_result);
+
+        const auto hashed_result = col::bench::measure(2ZU, [&]
+            {
+                const auto hit_res = (*hashed)(hit);
+                col::bench::do_not_optimize(hit_res);
+                const auto miss_res = (*hashed)(miss);
+                col::bench::do_not_optimize(miss_res);
+            });
+        col::bench::report(out, "possible_values/hashed", "candidates", Candidates, hashed_result);
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::FILE* out = col::bench::open_output(argc, argv);
+
+    bench_flat_options<1ZU>(out);
+    bench_flat_options<16ZU>(out);
+    bench_flat_options<128ZU>(out);
+    bench_flat_options<512ZU>(out);
+
+    bench_nested_subcommands<1ZU>(out);
+    bench_nested_subcommands<2ZU>(out);
+    bench_nested_subcommands<3ZU>(out);
+    bench_nested_subcommands<4ZU>(out);
+    bench_nested_subcommands<5ZU>(out);
+    bench_nested_subcommands<6ZU>(out);
+    bench_nested_subcommands<7ZU>(out);
+    bench_nested_subcommands<8ZU>(out);
+
+    bench_error_size<col::MaxCommandDepth>(out);
+
+    bench_long_argv<10'000ZU>(out);
+
+    bench_short_options(out);
+
+    bench_number_list<16ZU>(out);
+    bench_number_list<100'000ZU>(out);
+
+    bench_possible_values<8ZU>(out);
+    bench_possible_values<64ZU>(out);
+    bench_possible_values<512ZU>(out);
+    bench_possible_values<4096ZU>(out);
+
+    if( out != stdout )
+    {
+        std::fclose(out);
+    }
+    return EXIT_SUCCESS;
+}
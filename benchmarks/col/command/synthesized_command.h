@@ -0,0 +1,176 @@
+#pragma once
+
+#include <col/command.h>
+
+#include <cstddef>
+
+#include <array>
+#include <concepts>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// ベンチマークのために、オプションの個数やサブコマンドの深さを指定してコマンドを合成する。
+namespace col::bench {
+
+    namespace detail {
+
+        // `prefix` の後ろに `index` の 10 進表記を続けた、 `'\0'` で終端された名前を作る。
+        template <std::size_t N>
+        consteval std::array<char, 16> make_indexed_name(const char (&prefix)[N], std::size_t index)
+        {
+            std::array<char, 16> name{};
+            std::size_t pos = 0ZU;
+            for( ; pos + 1ZU < N; ++pos )
+            {
+                name[pos] = prefix[pos];
+            }
+            std::array<char, 8> digits{};
+            std::size_t length = 0ZU;
+            do
+            {
+                digits[length++] = static_cast<char>('0' + index % 10ZU);
+                index /= 10ZU;
+            } while( index > 0ZU );
+            while( length > 0ZU )
+            {
+                name[pos++] = digits[--length];
+            }
+            return name;
+        }
+
+    } // namespace detail
+
+    // 合成されたコマンドの `I` 番目のオプション名。 "opt<I>" 。
+    template <std::size_t I>
+    inline constexpr auto option_name = detail::make_indexed_name("opt", I);
+
+    // 合成されたコマンドの深さ `Depth` のサブコマンド名。 "level<Depth>" 。
+    template <std::size_t Depth>
+    inline constexpr auto level_name = detail::make_indexed_name("level", Depth);
+
+
+    // `int` のオプションを `N` 個持つコマンドのパース結果。
+    template <std::size_t N>
+    struct FlatTarget
+    {
+        std::array<int, N> values;
+
+        template <class ...Ts>
+        requires (sizeof...(Ts) == N && (std::same_as<Ts, int> && ...))
+        constexpr FlatTarget(Ts ...ts) noexcept
+        : values{ ts... }
+        {}
+    };
+
+    // `cmd` に `int` のオプション "opt<I>" ... "opt<N-1>" を追加する。
+    template <std::size_t I, std::size_t N, class C>
+    constexpr auto add_int_options(C&& cmd)
+    {
+        if constexpr( I == N )
+        {
+            return std::forward<C>(cmd);
+        }
+        else
+        {
+            return add_int_options<I + 1ZU, N>(std::forward<C>(cmd).add(col::Arg<int>{ option_name<I>.data(), "option" }));
+        }
+    }
+
+    // `int` のオプションを `N` 個持つコマンドを作る。
+    template <std::size_t N>
+    auto make_flat_cmd()
+    {
+        return add_int_options<0ZU, N>(col::Cmd{ "flat", "synthesized command" });
+    }
+
+    // `make_flat_cmd<N>()` が成功するコマンドライン引数。すべてのオプションを逆順に指定する。
+    template <std::size_t N>
+    std::vector<std::string> make_flat_args()
+    {
+        std::vector<std::string> args{};
+        args.reserve(N * 2ZU);
+        [&]<std::size_t ...Is>(std::index_sequence<Is...>)
+        {
+            ((args.emplace_back("--"), args.back().append(option_name<N - 1ZU - Is>.data()), args.emplace_back(std::to_string(Is))), ...);
+        }(std::make_index_sequence<N>{});
+        return args;
+    }
+
+
+    // 深さ `Depth` のコマンドのパース結果。 `Depth == 1` がサブコマンドを持たない末端となる。
+    template <std::size_t Depth>
+    struct NestedTarget
+    {
+        std::variant<std::monostate, NestedTarget<Depth - 1ZU>> sub;
+        int value;
+    };
+    template <>
+    struct NestedTarget<1ZU>
+    {
+        int value;
+    };
+
+    // 深さ `Depth` のサブコマンドを作る。
+    template <std::size_t Depth>
+    auto make_nested_subcmd()
+    {
+        if constexpr( Depth == 1ZU )
+        {
+            return col::SubCmd<NestedTarget<1ZU>>{ level_name<1ZU>.data(), "leaf" }
+                .add(col::Arg<int>{ "value", "value" });
+        }
+        else
+        {
+            return col::SubCmd<NestedTarget<Depth>>{ level_name<Depth>.data(), "level" }
+                .add(make_nested_subcmd<Depth - 1ZU>())
+                .add(col::Arg<int>{ "value", "value" });
+        }
+    }
+
+    // ルートを含めて `Depth` 段のコマンドを作る。各段は "--value" を 1 つ持つ。
+    template <std::size_t Depth>
+    auto make_nested_cmd()
+    {
+        if constexpr( Depth == 1ZU )
+        {
+            return col::Cmd{ "nested", "synthesized command" }
+                .add(col::Arg<int>{ "value", "value" });
+        }
+        else
+        {
+            return col::Cmd{ "nested", "synthesized command" }
+                .add(make_nested_subcmd<Depth - 1ZU>())
+                .add(col::Arg<int>{ "value", "value" });
+        }
+    }
+
+    // `make_nested_cmd<Depth>()` の末端のサブコマンドまで辿るコマンドライン引数。
+    template <std::size_t Depth>
+    std::vector<std::string> make_nested_args()
+    {
+        std::vector<std::string> args{ "--value", "0" };
+        for( std::size_t depth = Depth - 1ZU; depth > 0ZU; --depth )
+        {
+            args.emplace_back("level");
+            args.back().append(std::to_string(depth));
+            args.emplace_back("--value");
+            args.emplace_back(std::to_string(depth));
+        }
+        return args;
+    }
+
+    // `std::string` の列を、パースに渡す `const char*` の列にする。
+    inline std::vector<const char*> to_argv(const std::vector<std::string>& args)
+    {
+        std::vector<const char*> argv{};
+        argv.reserve(args.size());
+        for( const auto& arg : args )
+        {
+            argv.push_back(arg.c_str());
+        }
+        return argv;
+    }
+
+} // namespace col::bench
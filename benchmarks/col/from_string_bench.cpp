@@ -0,0 +1,110 @@
+#include "bench.h"
+
+#include <col/from_string.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace {
+
+    // トークンの個数。
+    constexpr std::size_t Tokens = 1024ZU;
+
+    // `make_token(i)` で作った `Tokens` 個のトークンを `col::number_from_string<T>` で変換する。
+    template <class T, class F>
+    void bench_number_from_string(std::FILE* out, std::string_view name, F make_token)
+    {
+        std::vector<std::string> tokens{};
+        tokens.reserve(Tokens);
+        for( std::size_t i = 0ZU; i < Tokens; ++i )
+        {
+            tokens.push_back(make_token(i));
+        }
+        for( const auto& token : tokens )
+        {
+            if( !col::number_from_string<T>(token).has_value() )
+            {
+                std::fprintf(stderr, "%.*s: cannot parse `%s`\n", static_cast<int>(name.size()), name.data(), token.c_str());
+                std::exit(EXIT_FAILURE);
+            }
+        }
+
+        const auto result = col::bench::measure(tokens.size(), [&]
+            {
+                for( const auto& token : tokens )
+                {
+                    const auto res = col::number_from_string<T>(token);
+                    col::bench::do_not_optimize(res);
+                }
+            });
+        col::bench::report(out, name, "tokens", tokens.size(), result);
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::FILE* out = col::bench::open_output(argc, argv);
+
+    bench_number_from_string<int>(out, "number_from_string/int32", [](std::size_t i)
+        {
+            return std::to_string(static_cast<int>(i * 2654435761ZU % 2'000'000'000ZU) - 1'000'000'000);
+        });
+    bench_number_from_string<std::int64_t>(out, "number_from_string/int64", [](std::size_t i)
+        {
+            return std::to_string(static_cast<std::int64_t>(i * 11400714819323198485ULL >> 1U));
+        });
+    bench_number_from_string<std::uint32_t>(out, "number_from_string/hex32", [](std::size_t i)
+        {
+            constexpr std::string_view digits = "0123456789abcdef";
+            auto value = static_cast<std::uint32_t>(i * 2654435761ZU);
+            std::string token{};
+            do
+            {
+                token.insert(token.begin(), digits[value % 16U]);
+                value /= 16U;
+            } while( value != 0U );
+            return "0x" + token;
+        });
+    bench_number_from_string<std::uint64_t>(out, "number_from_string/uint64_20digits", [](std::size_t i)
+        {
+            return std::to_string(10'000'000'000'000'000'000ULL + i * 11400714819323198485ULL % 8'000'000'000'000'000'000ULL);
+        });
+    bench_number_from_string<std::uint64_t>(out, "number_from_string/uint64_8digits", [](std::size_t i)
+        {
+            return std::to_string(10'000'000ULL + i * 2654435761ULL % 90'000'000ULL);
+        });
+    bench_number_from_string<std::uint64_t>(out, "number_from_string/hex64", [](std::size_t i)
+        {
+            constexpr std::string_view digits = "0123456789abcdef";
+            auto value = static_cast<std::uint64_t>(i * 11400714819323198485ULL) | (1ULL << 63U);
+            std::string token{};
+            do
+            {
+                token.insert(token.begin(), digits[value % 16U]);
+                value /= 16U;
+            } while( value != 0U );
+            return "0x" + token;
+        });
+    bench_number_from_string<int>(out, "number_from_string/short", [](std::size_t i)
+        {
+            return std::to_string(i % 100ZU);
+        });
+    bench_number_from_string<double>(out, "number_from_string/double", [](std::size_t i)
+        {
+            return std::to_string(static_cast<double>(i) * 1.25 - 300.0);
+        });
+
+    if( out != stdout )
+    {
+        std::fclose(out);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+#include "bench.h"
+
+#include <col/nonzero.h>
+#include <col/optional.h>
+#include <col/optional_vector.h>
+#include <col/relocate.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+    // 破棄された有効な `Resource` の個数。
+    std::size_t released_resources = 0ZU;
+
+    // ムーブと破棄が非トリビアルだが、自身のアドレスに依存しない型。
+    class Resource
+    {
+        std::uint64_t m_id;
+    public:
+        explicit Resource(std::uint64_t id) noexcept
+        : m_id{ id }
+        {}
+        Resource(Resource&& rhs) noexcept
+        : m_id{ std::exchange(rhs.m_id, 0U) }
+        {}
+        Resource& operator=(Resource&& rhs) noexcept
+        {
+            m_id = std::exchange(rhs.m_id, 0U);
+            return *this;
+        }
+        ~Resource()
+        {
+            if( m_id != 0U )
+            {
+                ++released_resources;
+            }
+        }
+    };
+
+} // namespace
+
+template <>
+struct col::is_trivially_relocatable<Resource> : std::true_type {};
+
+namespace {
+
+    // ID の個数。
+    constexpr std::size_t Elements = 1ZU << 20;
+
+    // `i` 番目の ID 。 4 つに 1 つを無効値とする。
+    constexpr std::uint64_t make_id(std::size_t i) noexcept
+    {
+        return i % 4ZU == 0ZU ? 0U : static_cast<std::uint64_t>(i) * 2654435761U + 1U;
+    }
+
+    // `i` 番目の測定値。 8 つに 1 つを欠測とする。
+    constexpr std::optional<double> make_measurement(std::size_t i) noexcept
+    {
+        if( i % 8ZU == 0ZU )
+        {
+            return std::nullopt;
+        }
+        return static_cast<double>(i % 1000ZU) * 0.25;
+    }
+
+    // `Elements` 個の省略可能な値の列を走査し、有効値の和を求める。
+    // 1 要素あたりの大きさを `bytes_per_element` として記録する。
+    template <class Sum, class Optional, class F>
+    void bench_optional_values(std::FILE* out, std::string_view name, F make_optional)
+    {
+        std::vector<Optional> values{};
+        values.reserve(Elements);
+        for( std::size_t i = 0ZU; i < Elements; ++i )
+        {
+            values.push_back(make_optional(i));
+        }
+
+        const auto result = col::bench::measure(values.size(), [&]
+            {
+                Sum sum{};
+                for( const auto& value : values )
+                {
+                    if( value.has_value() )
+                    {
+                        sum += static_cast<Sum>(*value);
+                    }
+                }
+                col::bench::do_not_optimize(sum);
+            });
+        col::bench::report(out, name, "bytes_per_element", sizeof(Optional), result);
+    }
+
+    // `bench_optional_values` の測定値の列を `col::optional_vector` に格納し、値の列とビット列を直接走査する。
+    // 有効値の有無は 1 要素あたり 1 ビットのため、 `bytes_per_element` は値の大きさになる。
+    void bench_optional_vector(std::FILE* out)
+    {
+        col::optional_vector<double> vec{};
+        vec.reserve(Elements);
+        for( std::size_t i = 0ZU; i < Elements; ++i )
+        {
+            if( const auto m = make_measurement(i); m.has_value() )
+            {
+                vec.push_back(*m);
+            }
+            else
+            {
+                vec.push_back(std::nullopt);
+            }
+        }
+
+        const auto sum_result = col::bench::measure(vec.size(), [&]
+            {
+                const auto values = vec.values();
+                const auto bits = vec.engaged_bits();
+                double sum = 0.0;
+                for( std::size_t i = 0ZU; i < values.size(); ++i )
+                {
+                    sum += ((bits[i / 64ZU] >> (i % 64ZU)) & 1U) != 0U ? values[i] : 0.0;
+                }
+                col::bench::do_not_optimize(sum);
+            });
+        col::bench::report(out, "optional_measurements/optional_vector", "bytes_per_element", sizeof(double), sum_result);
+
+        const auto count_result = col::bench::measure(vec.size(), [&]
+            {
+                const auto count = vec.count_engaged();
+                col::bench::do_not_optimize(count);
+            });
+        col::bench::report(out, "optional_measurements/count_engaged", "bytes_per_element", sizeof(double), count_result);
+    }
+
+    // `col::uninitialized_relocate` で要素を移す、容量を倍々に増やす最小限の列。
+    template <class T>
+    class RelocatingBuffer
+    {
+        std::allocator<T> m_alloc;
+        T* m_data;
+        std::size_t m_size;
+        std::size_t m_capacity;
+    public:
+        RelocatingBuffer() noexcept
+        : m_alloc{}
+        , m_data{ nullptr }
+        , m_size{ 0ZU }
+        , m_capacity{ 0ZU }
+        {}
+        RelocatingBuffer(const RelocatingBuffer&) = delete;
+        RelocatingBuffer& operator=(const RelocatingBuffer&) = delete;
+        ~RelocatingBuffer()
+        {
+            std::destroy(m_data, m_data + m_size);
+            if( m_data != nullptr )
+            {
+                m_alloc.deallocate(m_data, m_capacity);
+            }
+        }
+
+        template <class ...Args>
+        void emplace_back(Args&& ...args)
+        {
+            if( m_size == m_capacity )
+            {
+                const auto capacity = m_capacity == 0ZU ? 1ZU : m_capacity * 2ZU;
+                T* const data = m_alloc.allocate(capacity);
+                col::uninitialized_relocate(m_data, m_data + m_size, data);
+                if( m_data != nullptr )
+                {
+                    m_alloc.deallocate(m_data, m_capacity);
+                }
+                m_data = data;
+                m_capacity = capacity;
+            }
+            std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+            ++m_size;
+        }
+    };
+
+    // 要素数。
+    constexpr std::size_t GrowthElements = 1ZU << 16;
+
+    // 空の列に `GrowthElements` 個の省略可能な `Resource` を 1 つずつ追加する。
+    // `std::vector<std::optional<Resource>>` は再確保のたびにムーブと破棄を要素ごとに行い、
+    // `col::optional<Resource>` はトリビアルに再配置可能なため `RelocatingBuffer` ではバイト列の一括コピーで済む。
+    void bench_growth(std::FILE* out)
+    {
+        const auto std_result = col::bench::measure(GrowthElements, []
+            {
+                std::vector<std::optional<Resource>> vec{};
+                for( std::size_t i = 0ZU; i < GrowthElements; ++i )
+                {
+                    if( const auto id = make_id(i); id != 0U )
+                    {
+                        vec.emplace_back(std::in_place, id);
+                    }
+                    else
+                    {
+                        vec.emplace_back();
+                    }
+                }
+                col::bench::do_not_optimize(vec);
+            });
+        col::bench::report(out, "optional_growth/std_vector", "elements", GrowthElements, std_result);
+
+        const auto relocate_result = col::bench::measure(GrowthElements, []
+            {
+                RelocatingBuffer<col::optional<Resource>> vec{};
+                for( std::size_t i = 0ZU; i < GrowthElements; ++i )
+                {
+                    if( const auto id = make_id(i); id != 0U )
+                    {
+                        vec.emplace_back(std::in_place, id);
+                    }
+                    else
+                    {
+                        vec.emplace_back();
+                    }
+                }
+                col::bench::do_not_optimize(vec);
+            });
+        col::bench::report(out, "optional_growth/relocate", "elements", GrowthElements, relocate_result);
+    }
+
+    // 要素数。
+    constexpr std::size_t SortElements = 1ZU << 16;
+
+    // 省略可能な測定値の列を、無効値を先頭にして昇順に整列する。
+    template <class Optional>
+    void bench_sort(std::FILE* out, std::string_view name)
+    {
+        std::vector<Optional> source{};
+        source.reserve(SortElements);
+        for( std::size_t i = 0ZU; i < SortElements; ++i )
+        {
+            const auto m = make_measurement(i * 7919ZU % SortElements);
+            source.push_back(m.has_value() ? Optional{ *m } : Optional{});
+        }
+
+        std::vector<Optional> work(source.size());
+        const auto result = col::bench::measure(source.size(), [&]
+            {
+                std::ranges::copy(source, work.begin());
+                std::ranges::sort(work, [](const Optional& x, const Optional& y)
+                    {
+                        return y.has_value() && (!x.has_value() || *x < *y);
+                    });
+                col::bench::do_not_optimize(work);
+            });
+        col::bench::report(out, name, "bytes_per_element", sizeof(Optional), result);
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::FILE* out = col::bench::open_output(argc, argv);
+
+    bench_optional_values<std::uint64_t, std::optional<std::uint64_t>>(out, "optional_ids/std", [](std::size_t i)
+        {
+            const auto id = make_id(i);
+            return id == 0U ? std::nullopt : std::optional<std::uint64_t>{ id };
+        });
+    bench_optional_values<std::uint64_t, col::optional<std::uint64_t>>(out, "optional_ids/col", [](std::size_t i)
+        {
+            const auto id = make_id(i);
+            return id == 0U ? col::optional<std::uint64_t>{} : col::optional<std::uint64_t>{ id };
+        });
+    bench_optional_values<std::uint64_t, col::optional<col::NonZeroU64>>(out, "optional_ids/nonzero", [](std::size_t i)
+        {
+            return col::NonZeroU64::make_nonzero(make_id(i));
+        });
+
+    bench_optional_values<double, std::optional<double>>(out, "optional_measurements/std", [](std::size_t i)
+        {
+            return make_measurement(i);
+        });
+    bench_optional_values<double, col::optional<double>>(out, "optional_measurements/niche", [](std::size_t i)
+        {
+            const auto m = make_measurement(i);
+            return m.has_value() ? col::optional<double>{ *m } : col::optional<double>{};
+        });
+    bench_optional_vector(out);
+
+    bench_growth(out);
+    bench_sort<std::optional<double>>(out, "optional_sort/std");
+    bench_sort<col::optional<double>>(out, "optional_sort/niche");
+
+    if( out != stdout )
+    {
+        std::fclose(out);
+    }
+    return EXIT_SUCCESS;
+}
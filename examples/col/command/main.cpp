@@ -123,14 +123,14 @@ int main(int argc, char** argv)
     }
     else
     {
-        // col::ParseError の実体は std::variant です。
-        // 各エラー型は std::formatter を特殊化しており、文字列表示できます。
+        // col::ParseError はエラーの種類と位置、原因のトークンだけを保持する 16 バイトの値です。
+        // 種類は col::ParseError::kind() で得られます。
+        // オプション名などを含む詳細は、パースしたコマンドの explain() で std::variant である col::ParseErrorDetail として復元します。
+        // col::ParseErrorDetail と各エラー型は std::formatter を特殊化しており、文字列表示できます。
         // 
-        // 各コマンドおよびサブコマンドにはヘルプオプション("--help") が自動実装されます。指定されると、 col::ShowHelp が返ります。
-        // ヘルプメッセージの表示は std::format や col::ShowHelp::help_message を利用します。
-        std::visit([](const auto& e) static
-            {
-                std::println("{}", e);
-            }, res.error());
+        // 各コマンドおよびサブコマンドにはヘルプオプション("--help") が自動実装されます。指定されると、詳細が col::ShowHelp になるエラーが返ります。
+        // ヘルプメッセージの表示は std::format や col::ShowHelp::help_message() を利用します。
+        // ヘルプメッセージは書式化するときに生成されるため、それまでコマンドを破棄してはいけません。
+        std::println("{}", parser.explain(res.error()));
     }
 }
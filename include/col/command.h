@@ -2,6 +2,8 @@
 
 #include <col/control_flow.h>
 #include <col/from_string.h>
+#include <col/optional.h>
+#include <col/task.h>
 #include <col/tuple.h>
 #include <col/type_traits.h>
 
@@ -9,6 +11,9 @@
 #include <cstdint>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <concepts>
 #include <expected>
 #include <format>
@@ -16,12 +21,16 @@
 #include <iterator>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 
 namespace col {
@@ -44,14 +53,203 @@ namespace col {
         InternalLogicErrorKind kind;
     };
 
+    // コマンドの入れ子の深さの上限。
+    inline constexpr std::size_t MaxCommandDepth = 8ZU;
+
+    // 親コマンドの名前の列。ルートのコマンドから順に保持する。
+    //
+    // サブコマンドへ降りるたびに文字列を連結しないよう、固定長の配列に名前への参照を保持する。
+    class CommandPath
+    {
+        std::array<std::string_view, MaxCommandDepth> m_names;
+        std::size_t m_size;
+    public:
+        constexpr CommandPath() noexcept
+        : m_names{}
+        , m_size{ 0ZU }
+        {}
+
+        // 末尾に `name` を加えた `CommandPath` を返す。
+        // コマンドの入れ子の深さは `MaxCommandDepth` 以下であることが静的に検査されているため、あふれることはない。
+        [[nodiscard]] constexpr CommandPath push(std::string_view name) const noexcept
+        {
+            CommandPath path{ *this };
+            path.m_names[path.m_size] = name;
+            ++path.m_size;
+            return path;
+        }
+
+        // 親コマンドを持たなければ `true` 。
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return m_size == 0ZU;
+        }
+
+        // 親コマンドの名前をルートのコマンドから順に得る。
+        [[nodiscard]] constexpr std::span<const std::string_view> names() const noexcept
+        {
+            return std::span{ m_names.data(), m_size };
+        }
+    };
+
     // ヘルプメッセージを表示する。
+    //
+    // ヘルプメッセージそのものは保持せず、書式化の際に `cmd` から書式化先へ直接書き込む。
+    // そのため、 `cmd` が指すコマンドはこの値を書式化するまで生存していなければならない。
+    // 親コマンドの名前の列も保持せず、 `cmd` から `--help` が指定されたサブコマンドまでのインデックスの列だけを保持する。
+    // パース結果として返る時点では、 `cmd` はルートのコマンドを指す。
     struct ShowHelp
     {
-        std::string help_message;
+        // `cmd` から `path` をたどった先のコマンドの usage 文字列を書式化先 `out` に書き込む関数の型。
+        // `parent` は `cmd` の親コマンドの名前の列。
+        using render_fn = std::format_context::iterator (*)(const void* cmd, std::span<const std::uint8_t> path, const CommandPath& parent, std::format_context::iterator out);
+
+        // `--help` が指定されたコマンド、またはその祖先のコマンド。
+        const void* cmd;
+        // `cmd` から `path` をたどった先のコマンドの usage 文字列を生成する関数。
+        render_fn render;
+        // `cmd` から `--help` が指定されたコマンドまでたどる、各階層のサブコマンドのインデックスの列。
+        std::array<std::uint8_t, MaxCommandDepth> path;
+        // `path` の長さ。
+        std::uint8_t depth;
+
+        // ヘルプメッセージを文字列として生成する。
+        [[nodiscard]] std::string help_message() const;
+    };
+
+    // 不明なオプションに対して提案する、綴りの近い名前。
+    struct NameSuggestion
+    {
+        std::string_view name;
+        // オプション名であれば `true` 、サブコマンド名であれば `false` 。
+        bool is_option;
     };
 
+    namespace detail {
+
+        // 文字列 `pattern` との編集距離 (レーベンシュタイン距離) を、 Myers のビット並列アルゴリズムで計算する。
+        //
+        // `pattern` の各文字の位置をビットとする表を 1 度だけ作り、比較する文字列の 1 文字あたり定数回のビット演算で距離を更新する。
+        // `pattern` は 64 文字以下でなければならない。
+        class EditDistance
+        {
+            std::array<std::uint64_t, 256ZU> m_peq;
+            std::size_t m_size;
+        public:
+            constexpr explicit EditDistance(std::string_view pattern) noexcept
+            : m_peq{}
+            , m_size{ pattern.size() }
+            {
+                for( std::size_t i = 0ZU; i < pattern.size(); ++i )
+                {
+                    m_peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{ 1 } << i;
+                }
+            }
+
+            // `pattern` と `text` の編集距離を得る。
+            [[nodiscard]] constexpr std::size_t operator()(std::string_view text) const noexcept
+            {
+                if( m_size == 0ZU )
+                {
+                    return text.size();
+                }
+                const std::uint64_t last = std::uint64_t{ 1 } << (m_size - 1ZU);
+                std::uint64_t pv = ~std::uint64_t{ 0 };
+                std::uint64_t mv = 0;
+                std::size_t score = m_size;
+                for( const char c : text )
+                {
+                    const auto eq = m_peq[static_cast<unsigned char>(c)];
+                    const auto xv = eq | mv;
+                    const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+                    auto ph = mv | ~(xh | pv);
+                    auto mh = pv & xh;
+                    if( (ph & last) != 0 )
+                    {
+                        ++score;
+                    }
+                    else if( (mh & last) != 0 )
+                    {
+                        --score;
+                    }
+                    ph = (ph << 1) | 1;
+                    mh <<= 1;
+                    pv = mh | ~(xv | ph);
+                    mv = ph & xv;
+                }
+                return score;
+            }
+        };
+
+        // `EditDistance` が扱える文字列の長さの上限。
+        inline constexpr std::size_t MaxEditDistancePatternSize = 64ZU;
+
+        // トークン `arg` から先頭の `-` と `=` 以降を除いた名前に最も綴りの近い名前を、オプション名 `options` 、サブコマンド名 `subcommands` の順に探す。
+        // 編集距離が長い方の名前の長さの半分以下のものだけを候補とし、同じ距離であれば先に見つかった名前を返す。
+        [[nodiscard]] constexpr std::optional<NameSuggestion> suggest_name(
+            std::string_view arg, std::span<const std::string_view> options, std::span<const std::string_view> subcommands) noexcept
+        {
+            auto name = arg.substr(std::min(arg.find_first_not_of('-'), arg.size()));
+            name = name.substr(0ZU, name.find('='));
+            if( name.empty() || name.size() > MaxEditDistancePatternSize )
+            {
+                return std::nullopt;
+            }
+
+            const EditDistance distance{ name };
+            std::optional<NameSuggestion> best{};
+            std::size_t best_distance = name.size();
+            const auto find_in = [&](std::span<const std::string_view> names, bool is_option) noexcept
+                {
+                    for( const auto candidate : names )
+                    {
+                        const auto d = distance(candidate);
+                        if( d * 2ZU <= std::max(name.size(), candidate.size()) && (!best.has_value() || d < best_distance) )
+                        {
+                            best = NameSuggestion{
+                                .name = candidate,
+                                .is_option = is_option,
+                            };
+                            best_distance = d;
+                        }
+                    }
+                };
+            find_in(options, true);
+            find_in(subcommands, false);
+            return best;
+        }
+
+    } // namespace detail
+
     // 不明なオプション。
+    //
+    // 綴りの近い名前の提案は書式化の際に初めて計算し、それまではパースに失敗した階層のコマンドを指すだけにとどめる。
+    // そのため、 `cmd` が指すコマンドはこの値を書式化するまで生存していなければならない。
+    // 定数式の評価中は、結果がコマンドの寿命に縛られないよう `cmd` を持たない。
     struct UnknownOption
+    {
+        // `cmd` のオプション名とサブコマンド名から、 `arg` に綴りの近い名前を探す関数の型。
+        using suggest_fn = std::optional<NameSuggestion> (*)(const void* cmd, std::string_view arg) noexcept;
+
+        std::string_view arg;
+        // パースに失敗した階層のコマンド。
+        const void* cmd;
+        // `cmd` から綴りの近い名前を探す関数。
+        suggest_fn suggest;
+
+        // `arg` に綴りの近いオプション名またはサブコマンド名を得る。
+        [[nodiscard]] std::optional<NameSuggestion> suggestion() const noexcept
+        {
+            if( cmd == nullptr )
+            {
+                return std::nullopt;
+            }
+            return suggest(cmd, arg);
+        }
+    };
+
+    // オプション名の前置きが複数のオプション名に一致した。
+    struct AmbiguousOption
     {
         std::string_view arg;
     };
@@ -68,6 +266,13 @@ namespace col {
         std::string_view name;
     };
 
+    // 値を取らないオプションに対して `--name=value` の形式で値が与えられた。
+    struct UnexpectedOptionValue
+    {
+        std::string_view name;
+        std::string_view arg;
+    };
+
     // 数値として不正な文字列を受け取った。
     struct InvalidNumber
     {
@@ -76,6 +281,15 @@ namespace col {
         std::errc err;
     };
 
+    // 固定長の列に対して要素数の異なる値の列を受け取った。
+    struct InvalidListLength
+    {
+        std::string_view name;
+        std::string_view arg;
+        std::uint32_t expected;
+        std::uint32_t actual;
+    };
+
     // 構造体にマッピングするには引数が足りない。
     struct NotEnoughArgument
     {
@@ -118,26 +332,128 @@ namespace col {
         std::string_view name;
     };
 
-    // パーサーが返すエラー。
-    using ParseError =
+    // エラーの詳細。 `col::Cmd::explain()` が `ParseError` から復元する。
+    using ParseErrorDetail =
         std::variant<
             UnknownError,
             InternalLogicError,
             UnknownOption,
+            AmbiguousOption,
             ShowHelp,
             DuplicateOption,
             MissingOptionValue,
+            UnexpectedOptionValue,
             ValueParserError,
             DefaultValueError,
             InvalidNumber,
+            InvalidListLength,
             NotEnoughArgument,
             InvalidConfiguration,
             MissingRequiredOption
         >;
+
+    // エラーの種類。 `ParseErrorDetail` の同じ位置の型に対応する。
+    enum class ParseErrorKind : std::uint8_t
+    {
+        UnknownError,
+        InternalLogicError,
+        UnknownOption,
+        AmbiguousOption,
+        ShowHelp,
+        DuplicateOption,
+        MissingOptionValue,
+        UnexpectedOptionValue,
+        ValueParserError,
+        DefaultValueError,
+        InvalidNumber,
+        InvalidListLength,
+        NotEnoughArgument,
+        InvalidConfiguration,
+        MissingRequiredOption,
+    };
+
+    // パーサーが返すエラー。
+    //
+    // パースに成功した場合も `std::expected<T, ParseError>` として各階層を受け渡すため、
+    // エラーの種類、エラーが生じた位置、原因となったトークンだけを 16 バイトに収め、トリビアルにコピーできるようにする。
+    // オプション名などの詳細は保持せず、 `col::Cmd::explain()` でパースしたコマンドから復元する。
+    // そのため、パースしたコマンドとトークンが指す文字列は、詳細を復元するまで生存していなければならない。
+    class ParseError
+    {
+        // 原因となったトークン。
+        const char* m_token;
+        std::uint32_t m_token_size;
+        // エラーが生じた位置。エラーを返したコマンドを 0 、その `i` 番目のオプションを `i + 1` とし、
+        // 続けて各サブコマンドの部分木の位置を同じ順で数える。
+        std::uint16_t m_site;
+        ParseErrorKind m_kind;
+        // 種類ごとの付加情報。 `InvalidNumber` では `std::errc` 、 `InvalidConfiguration` では `InvalidConfigKind` 、
+        // `InternalLogicError` では `InternalLogicErrorKind` の値を保持する。
+        std::uint8_t m_detail;
+    public:
+        constexpr explicit ParseError(ParseErrorKind kind, std::string_view token = {}, std::uint8_t detail = 0U) noexcept
+        : m_token{ token.data() }
+        , m_token_size{ static_cast<std::uint32_t>(token.size()) }
+        , m_site{ 0U }
+        , m_kind{ kind }
+        , m_detail{ detail }
+        {}
+
+        // パーサーが返したエラーから構築する。
+        // オプション名は保持せず、どのオプションのエラーかはパースしたコマンドが記録する。
+        constexpr ParseError(const ValueParserError& err) noexcept
+        : ParseError{ ParseErrorKind::ValueParserError, err.arg }
+        {}
+        constexpr ParseError(const InvalidNumber& err) noexcept
+        : ParseError{ ParseErrorKind::InvalidNumber, err.arg, static_cast<std::uint8_t>(err.err) }
+        {}
+
+        [[nodiscard]] constexpr ParseErrorKind kind() const noexcept
+        {
+            return m_kind;
+        }
+
+        // 原因となったトークン。なければ空。
+        [[nodiscard]] constexpr std::string_view token() const noexcept
+        {
+            return std::string_view{ m_token, m_token_size };
+        }
+
+        // エラーが生じた位置。
+        [[nodiscard]] constexpr std::size_t site() const noexcept
+        {
+            return m_site;
+        }
+
+        // 種類ごとの付加情報。
+        [[nodiscard]] constexpr std::uint8_t detail() const noexcept
+        {
+            return m_detail;
+        }
+
+        // エラーが生じた位置を `site` とした値を得る。
+        [[nodiscard]] constexpr ParseError at_site(std::size_t site) const noexcept
+        {
+            ParseError err{ *this };
+            err.m_site = static_cast<std::uint16_t>(site);
+            return err;
+        }
+
+        // エラーが生じた位置を `offset` だけ後ろにずらした値を得る。
+        // サブコマンドのエラーを親のコマンドのエラーとするときに用いる。
+        [[nodiscard]] constexpr ParseError shift_site(std::size_t offset) const noexcept
+        {
+            return at_site(m_site + offset);
+        }
+
+        friend constexpr bool operator==(const ParseError&, const ParseError&) noexcept = default;
+    };
+
+    static_assert(sizeof(ParseError) <= 16ZU && std::is_trivially_copyable_v<ParseError>);
 } // namespace col
 
 
-// std::formatter の col::ParseError に対する特殊化
+// std::formatter の col::ParseErrorDetail に対する特殊化
 
 template <>
 struct std::formatter<col::UnknownError> : std::formatter<const char*>
@@ -185,19 +501,46 @@ struct std::formatter<col::UnknownOption>
     }
     auto format(const col::UnknownOption& err, std::format_context& ctx) const
     {
-        return std::format_to(ctx.out(), "unknown option: arg='{}'", err.arg);
+        auto out = std::format_to(ctx.out(), "unknown option: arg='{}'", err.arg);
+        if( const auto suggestion = err.suggestion(); suggestion.has_value() )
+        {
+            out = std::format_to(std::move(out), " (did you mean '{}{}'?)", suggestion->is_option ? "--" : "", suggestion->name);
+        }
+        return out;
+    }
+};
+
+template <>
+struct std::formatter<col::AmbiguousOption>
+{
+    constexpr auto parse(std::format_parse_context& ctx) const noexcept
+    {
+        return ctx.begin();
+    }
+    auto format(const col::AmbiguousOption& err, std::format_context& ctx) const
+    {
+        return std::format_to(ctx.out(), "ambiguous option: arg='{}'", err.arg);
     }
 };
 
 template <>
-struct std::formatter<col::ShowHelp> : std::formatter<const char*>
+struct std::formatter<col::ShowHelp>
 {
-    auto format(const col::ShowHelp& err, std::format_context& ctx) const noexcept
+    constexpr auto parse(std::format_parse_context& ctx) const noexcept
+    {
+        return ctx.begin();
+    }
+    auto format(const col::ShowHelp& err, std::format_context& ctx) const
     {
-        return std::format_to(ctx.out(), "{}", err.help_message);
+        return err.render(err.cmd, std::span{ err.path.data(), err.depth }, col::CommandPath{}, ctx.out());
     }
 };
 
+inline std::string col::ShowHelp::help_message() const
+{
+    return std::format("{}", *this);
+}
+
 
 template <>
 struct std::formatter<col::DuplicateOption>
@@ -225,6 +568,19 @@ struct std::formatter<col::MissingOptionValue>
     }
 };
 
+template <>
+struct std::formatter<col::UnexpectedOptionValue>
+{
+    constexpr auto parse(std::format_parse_context& ctx) const noexcept
+    {
+        return ctx.begin();
+    }
+    auto format(const col::UnexpectedOptionValue& err, std::format_context& ctx) const
+    {
+        return std::format_to(ctx.out(), "unexpected value for option: name='{}' arg='{}'", err.name, err.arg);
+    }
+};
+
 template <>
 struct std::formatter<col::InvalidNumber>
 {
@@ -240,6 +596,21 @@ struct std::formatter<col::InvalidNumber>
     }
 };
 
+template <>
+struct std::formatter<col::InvalidListLength>
+{
+    constexpr auto parse(std::format_parse_context& ctx) const noexcept
+    {
+        return ctx.begin();
+    }
+    auto format(const col::InvalidListLength& err, std::format_context& ctx) const
+    {
+        return std::format_to(ctx.out(),
+            "invalid list length: option='{}' arg='{}' expected='{}' actual='{}'",
+            err.name, err.arg, err.expected, err.actual);
+    }
+};
+
 template <>
 struct std::formatter<col::NotEnoughArgument>
 {
@@ -326,6 +697,22 @@ struct std::formatter<col::MissingRequiredOption>
     }
 };
 
+template <>
+struct std::formatter<col::ParseErrorDetail>
+{
+    constexpr auto parse(std::format_parse_context& ctx) const noexcept
+    {
+        return ctx.begin();
+    }
+    auto format(const col::ParseErrorDetail& err, std::format_context& ctx) const
+    {
+        return std::visit([&ctx](const auto& e)
+            {
+                return std::format_to(ctx.out(), "{}", e);
+            }, err);
+    }
+};
+
 namespace col {
 
     // 空の型。
@@ -388,28 +775,172 @@ namespace col {
     using deduce_default_type_t = deduce_default_value_type<D>::type;
 
 
+    // パーサーの型 `P` に渡すコマンドライン引数の型。
+    // `std::string_view` で呼び出せればその型を優先し、そうでなければ `const char*` 。
+    template <class P>
+    using value_parser_argument_t = std::conditional_t<std::invocable<P, std::string_view>, std::string_view, const char*>;
+
+    // パーサーの型 `P` の戻り値の型。
+    template <class P>
+    using value_parser_result_t = std::invoke_result_t<P, value_parser_argument_t<P>>;
+
     // 型 `P` が `col::Arg` のパーサーとして指定できる型であることを示すコンセプト。
+    // パーサーは `std::string_view` または `const char*` を引数に取る。
+    // `std::string_view` を取るパーサーは、 `--name=value` の値などを元のバッファを指すポインタと長さのまま受け取る。
+    // パーサーは `col::Task` を返して、値を非同期に生成してもよい。
     template <class P>
     concept value_parser_type = (
         std::is_object_v<P> &&
         !std::same_as<std::remove_cvref_t<P>, blank> &&
         !is_col_deduced_v<std::remove_cvref_t<P>> &&
-        std::invocable<P, const char*> &&
-        !std::is_void_v<col::unwrap_ok_type_if_t<std::invoke_result_t<P, const char*>>> &&
-        !std::same_as<std::remove_cvref_t<col::unwrap_ok_type_if_t<std::invoke_result_t<P, const char*>>>, blank> &&
-        !is_col_deduced_v<std::remove_cvref_t<col::unwrap_ok_type_if_t<std::invoke_result_t<P, const char*>>>>
+        (std::invocable<P, std::string_view> || std::invocable<P, const char*>) &&
+        !std::is_void_v<col::unwrap_ok_type_if_t<col::unwrap_task_type_if_t<value_parser_result_t<P>>>> &&
+        !std::same_as<std::remove_cvref_t<col::unwrap_ok_type_if_t<col::unwrap_task_type_if_t<value_parser_result_t<P>>>>, blank> &&
+        !is_col_deduced_v<std::remove_cvref_t<col::unwrap_ok_type_if_t<col::unwrap_task_type_if_t<value_parser_result_t<P>>>>>
+    );
+
+    // 型 `P` が `col::Task` を返す非同期のパーサーであることを示すコンセプト。
+    template <class P>
+    concept async_value_parser_type = (
+        value_parser_type<P> &&
+        is_col_task_v<value_parser_result_t<P>>
     );
 
     // パーサーの型 `P` から得られる型を推論し、メンバ型 `type` として定義する。
     template <value_parser_type P>
     struct deduce_value_parser_type
     {
-        using type = col::unwrap_ok_type_if_t<std::invoke_result_t<P, const char*>>;
+        using type = col::unwrap_ok_type_if_t<col::unwrap_task_type_if_t<value_parser_result_t<P>>>;
     };
     // パーサーの型 `P` から得られる型。
     template <class P>
     using deduce_parser_type_t = deduce_value_parser_type<P>::type;
 
+    // 区切り文字で区切られた数値の列として、パーサーを指定せずに `col::Arg` で変換できる型であることを示すコンセプト。
+    template <class T>
+    concept number_list_type = (
+        (is_std_vector_v<T> || is_std_array_v<T>) &&
+        (
+            (
+                std::integral<typename T::value_type> &&
+                !std::same_as<typename T::value_type, bool>
+            ) ||
+            std::floating_point<typename T::value_type>
+        )
+    );
+
+    namespace detail {
+
+        // 文字列の FNV-1a ハッシュ値を計算する。
+        [[nodiscard]] constexpr std::uint64_t fnv1a_hash(std::string_view str) noexcept
+        {
+            std::uint64_t hash = 0xcbf29ce484222325ULL;
+            for( const char c : str )
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+        // 名前からその名前を持つ要素のインデックスを引く、要素数 `N` の開番地法ハッシュテーブルのスロット。
+        //
+        // 名前そのものは保持せず、構築と検索のたびに `name_at(i)` で `i` 番目の名前を得る。
+        // そのため、名前を所有する `std::string` などの列と一緒に保持しても、コピーやムーブで名前への参照が無効にならない。
+        // 同じ名前が複数ある場合は、先に登録された要素のインデックスが引かれる。
+        template <std::size_t N>
+        class NameSlotTable
+        {
+            using index_type = std::uint16_t;
+            static_assert(N < 0xFFFFZU, "too many names for a single command");
+
+            // 空きスロットが必ず残るように要素数の 2 倍以上の 2 の冪とする。
+            static constexpr std::size_t Capacity = std::bit_ceil(N * 2ZU + 1ZU);
+            static constexpr index_type EmptySlot = static_cast<index_type>(N);
+
+            std::array<index_type, Capacity> m_slots;
+
+        public:
+            template <class F>
+            requires (std::is_nothrow_invocable_r_v<std::string_view, const F&, std::size_t>)
+            constexpr explicit NameSlotTable(const F& name_at) noexcept
+            : m_slots{}
+            {
+                m_slots.fill(EmptySlot);
+                for( std::size_t i = 0ZU; i < N; ++i )
+                {
+                    const std::string_view name = name_at(i);
+                    auto slot = static_cast<std::size_t>(fnv1a_hash(name)) & (Capacity - 1ZU);
+                    bool duplicated = false;
+                    while( m_slots[slot] != EmptySlot )
+                    {
+                        if( name_at(m_slots[slot]) == name )
+                        {
+                            duplicated = true;
+                            break;
+                        }
+                        slot = (slot + 1ZU) & (Capacity - 1ZU);
+                    }
+                    if( !duplicated )
+                    {
+                        m_slots[slot] = static_cast<index_type>(i);
+                    }
+                }
+            }
+
+            // 名前 `name` を持つ要素のインデックスを得る。見つからなければ `std::nullopt` を返す。
+            // `name_at` は構築時と同じ名前の列を返さなければならない。
+            template <class F>
+            requires (std::is_nothrow_invocable_r_v<std::string_view, const F&, std::size_t>)
+            [[nodiscard]] constexpr std::optional<std::size_t> find(std::string_view name, const F& name_at) const noexcept
+            {
+                auto slot = static_cast<std::size_t>(fnv1a_hash(name)) & (Capacity - 1ZU);
+                while( m_slots[slot] != EmptySlot )
+                {
+                    const std::size_t index = m_slots[slot];
+                    if( name_at(index) == name )
+                    {
+                        return index;
+                    }
+                    slot = (slot + 1ZU) & (Capacity - 1ZU);
+                }
+                return std::nullopt;
+            }
+        };
+
+        // 名前からその名前を持つ要素のインデックスを引く、要素数 `N` の開番地法ハッシュテーブル。
+        //
+        // Cmd, SubCmd の構築時にオプション名・サブコマンド名から生成される。
+        // `constexpr` なコマンドではコンパイル時に生成される。
+        // 名前は `std::string_view` として保持するため、名前の文字列はこのテーブルより長く生存していなければならない。
+        // 同じ名前が複数ある場合は、先に登録された要素のインデックスが引かれる。
+        template <std::size_t N>
+        class NameIndexTable
+        {
+            std::array<std::string_view, N> m_names;
+            NameSlotTable<N> m_slots;
+
+        public:
+            constexpr explicit NameIndexTable(const std::array<std::string_view, N>& names) noexcept
+            : m_names{ names }
+            , m_slots{ [this](std::size_t i) noexcept { return m_names[i]; } }
+            {}
+
+            // 名前 `name` を持つ要素のインデックスを得る。見つからなければ `std::nullopt` を返す。
+            [[nodiscard]] constexpr std::optional<std::size_t> find(std::string_view name) const noexcept
+            {
+                return m_slots.find(name, [this](std::size_t i) noexcept { return m_names[i]; });
+            }
+
+            // 登録された名前を登録順に得る。
+            [[nodiscard]] constexpr const std::array<std::string_view, N>& names() const noexcept
+            {
+                return m_names;
+            }
+        };
+
+    } // namespace detail
+
     // 候補となる値から選択するパーサー
     template <class T>
     requires (std::convertible_to<T, std::string_view>)
@@ -430,14 +961,23 @@ namespace col {
         : m_possible_values{ init }
         {}
 
-        constexpr std::optional<T> operator()(const char* str) const
+        constexpr std::optional<T> operator()(std::string_view s) const
+        {
+            if( const auto pv = find(s); pv.has_value() )
+            {
+                return std::optional{ *pv };
+            }
+            return std::nullopt;
+        }
+
+        // 文字列 `s` に一致する候補への参照を得る。一致する候補がなければ無効値を返す。
+        [[nodiscard]] constexpr col::optional<const T&> find(std::string_view s) const noexcept
         {
-            const std::string_view s{str};
             for( const auto& pv : m_possible_values )
             {
                 if( std::string_view{pv} == s )
                 {
-                    return std::optional{pv};
+                    return col::optional<const T&>{ pv };
                 }
             }
             return std::nullopt;
@@ -454,30 +994,176 @@ namespace col {
     requires (sizeof...(Args) > 0)
     PossibleValueParser(Args...) -> PossibleValueParser<Args...>;
 
+    // 候補となる値から、開番地法のハッシュテーブルを引いて選択するパーサー。
+    //
+    // 候補の数 `N` によらず、 1 回のパースはトークンのハッシュ値の計算と少数の比較で済む。
+    // 候補は `std::array` に保持されるため、 `constexpr` なコマンドではテーブルもコンパイル時に生成される。
+    // 同じ候補が複数ある場合は、先の候補が選択される。
+    template <class T, std::size_t N>
+    requires (std::convertible_to<T, std::string_view>)
+    class PossibleValueSet
+    {
+        std::array<T, N> m_possible_values;
+        // 候補は `m_possible_values` から引くため、 `T` が `std::string` でもコピーやムーブの後に参照が無効にならない
+        detail::NameSlotTable<N> m_index;
+
+        // `i` 番目の候補の名前を得る。
+        [[nodiscard]] constexpr std::string_view name_at(std::size_t i) const noexcept
+        {
+            return std::string_view{ m_possible_values[i] };
+        }
+    public:
+        constexpr explicit PossibleValueSet(const std::array<T, N>& possible_values)
+        : m_possible_values{ possible_values }
+        , m_index{ [this](std::size_t i) noexcept { return name_at(i); } }
+        {}
+
+        template <class ...Args>
+        requires (
+            sizeof...(Args) == N &&
+            (std::convertible_to<Args, T> && ...)
+        )
+        constexpr PossibleValueSet(Args ...args)
+        : PossibleValueSet{ std::array<T, N>{ static_cast<T>(args)... } }
+        {}
+
+        constexpr std::optional<T> operator()(std::string_view s) const
+        {
+            if( const auto pv = find(s); pv.has_value() )
+            {
+                return std::optional{ *pv };
+            }
+            return std::nullopt;
+        }
+
+        // 文字列 `s` に一致する候補への参照を得る。一致する候補がなければ無効値を返す。
+        [[nodiscard]] constexpr col::optional<const T&> find(std::string_view s) const noexcept
+        {
+            if( const auto index = index_of(s); index.has_value() )
+            {
+                return col::optional<const T&>{ m_possible_values[*index] };
+            }
+            return std::nullopt;
+        }
+
+        // 文字列 `s` に一致する候補のインデックスを得る。一致する候補がなければ `std::nullopt` を返す。
+        [[nodiscard]] constexpr std::optional<std::size_t> index_of(std::string_view s) const noexcept
+        {
+            return m_index.find(s, [this](std::size_t i) noexcept { return name_at(i); });
+        }
+    };
+    // 推論ガイド
+    template <class T, std::size_t N>
+    PossibleValueSet(const std::array<T, N>&) -> PossibleValueSet<T, N>;
+    // 推論ガイド
+    template <class ...Args>
+    requires (sizeof...(Args) > 0)
+    PossibleValueSet(Args...) -> PossibleValueSet<std::common_type_t<Args...>, sizeof...(Args)>;
+
+    namespace detail {
+        // `PossibleValueMap` が名前を保持する型。文字列リテラルなどのポインタは `std::string_view` として保持する。
+        template <class Name>
+        using possible_value_name_t = std::conditional_t<std::is_pointer_v<std::decay_t<Name>>, std::string_view, std::decay_t<Name>>;
+    } // namespace detail
+
+    // 候補となる名前から、対応する値 `V` を開番地法のハッシュテーブルを引いて選択するパーサー。
+    //
+    // 名前の文字列ではなく、列挙子などの値 `V` を返す。
+    // 名前は `Name` として自身が保持するため、 `Name` が `std::string` でもコピーやムーブの後に参照が無効にならない。
+    // 同じ名前が複数ある場合は、先の名前に対応する値が選択される。
+    template <class V, std::size_t N, class Name = std::string_view>
+    requires (std::convertible_to<const Name&, std::string_view>)
+    class PossibleValueMap
+    {
+        std::array<Name, N> m_names;
+        std::array<V, N> m_values;
+        detail::NameSlotTable<N> m_index;
+
+        // `i` 番目の名前を得る。
+        [[nodiscard]] constexpr std::string_view name_at(std::size_t i) const noexcept
+        {
+            return std::string_view{ m_names[i] };
+        }
+    public:
+        constexpr explicit PossibleValueMap(const std::array<std::pair<Name, V>, N>& entries)
+        : m_names{ [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+            {
+                return std::array<Name, N>{ entries[Idx].first... };
+            }(std::make_index_sequence<N>{}) }
+        , m_values{ [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+            {
+                return std::array<V, N>{ entries[Idx].second... };
+            }(std::make_index_sequence<N>{}) }
+        , m_index{ [this](std::size_t i) noexcept { return name_at(i); } }
+        {}
+
+        // `Name` が `std::string_view` などの参照であれば、 `std::string` などの所有する名前からは構築できない。
+        // 引数の名前はこのコンストラクタを抜けると破棄されるため。
+        template <class ...Names>
+        requires (
+            sizeof...(Names) == N &&
+            (std::convertible_to<Names, Name> && ...) &&
+            (!std::is_trivially_copyable_v<Name> || (std::is_trivially_copyable_v<Names> && ...))
+        )
+        constexpr PossibleValueMap(std::pair<Names, V> ...entries)
+        : PossibleValueMap{ std::array<std::pair<Name, V>, N>{ std::pair<Name, V>{ std::move(entries.first), std::move(entries.second) }... } }
+        {}
+
+        constexpr std::optional<V> operator()(std::string_view s) const
+        {
+            if( const auto value = find(s); value.has_value() )
+            {
+                return std::optional{ *value };
+            }
+            return std::nullopt;
+        }
+
+        // 名前 `s` に対応する値への参照を得る。一致する名前がなければ無効値を返す。
+        [[nodiscard]] constexpr col::optional<const V&> find(std::string_view s) const noexcept
+        {
+            if( const auto index = index_of(s); index.has_value() )
+            {
+                return col::optional<const V&>{ m_values[*index] };
+            }
+            return std::nullopt;
+        }
+
+        // 名前 `s` に一致する候補のインデックスを得る。一致する候補がなければ `std::nullopt` を返す。
+        [[nodiscard]] constexpr std::optional<std::size_t> index_of(std::string_view s) const noexcept
+        {
+            return m_index.find(s, [this](std::size_t i) noexcept { return name_at(i); });
+        }
+    };
+    // 推論ガイド
+    template <class Name, class V, std::size_t N>
+    PossibleValueMap(const std::array<std::pair<Name, V>, N>&) -> PossibleValueMap<V, N, Name>;
+    // 推論ガイド
+    template <class Name, class V, class ...Rest>
+    PossibleValueMap(std::pair<Name, V>, Rest...) -> PossibleValueMap<V, sizeof...(Rest) + 1ZU, detail::possible_value_name_t<std::common_type_t<Name, typename Rest::first_type...>>>;
+
+    // 型 `D` と `P` の組がデフォルト値とパーサーとして `col::Arg` に指定されたときに適合することを示すコンセプト。
+    template <class D, class P>
+    concept default_and_parser_compatible = (
+        (
+            std::same_as<D, blank> &&
+            value_parser_type<P>
+        ) ||
+        (
+            default_value_type<D> &&
+            std::same_as<P, blank>
+        ) ||
+        (
+            default_value_type<D> &&
+            value_parser_type<P> &&
+            requires {
+                typename std::common_type_t<
+                    deduce_default_type_t<D>,
+                    deduce_parser_type_t<P>
+                >;
+            }
+        )
+    );
 
-    // 型 `D` と `P` の組がデフォルト値とパーサーとして `col::Arg` に指定されたときに適合することを示すコンセプト。
-    template <class D, class P>
-    concept default_and_parser_compatible = (
-        (
-            std::same_as<D, blank> &&
-            value_parser_type<P>
-        ) ||
-        (
-            default_value_type<D> &&
-            std::same_as<P, blank>
-        ) ||
-        (
-            default_value_type<D> &&
-            value_parser_type<P> &&
-            requires {
-                typename std::common_type_t<
-                    deduce_default_type_t<D>,
-                    deduce_parser_type_t<P>
-                >;
-            }
-        )
-    );
-
     namespace detail {
         template <class D, class P>
         struct deduce_value_type : std::common_type<deduce_default_type_t<D>, deduce_parser_type_t<P>> {};
@@ -535,9 +1221,46 @@ namespace col {
         }
     };
 
+    // 短いオプション名として適格な文字。英数字 1 文字。
+    class ShortOptionName
+    {
+        template <class>
+        void invalid_name(){}
+        struct invalid_character{};
+
+        const char m_name;
+    public:
+        consteval ShortOptionName(char name) noexcept
+        : m_name{ name }
+        {
+            if( !(('a' <= name && name <= 'z') ||
+                ('A' <= name && name <= 'Z') ||
+                ('0' <= name && name <= '9')) )
+            {
+                invalid_name<invalid_character>();
+            }
+        }
+
+        constexpr operator char() const noexcept
+        {
+            return m_name;
+        }
+    };
+
     // usage の表示におけるインデント幅の既定値。スペースの個数。
     inline constexpr std::size_t DefaultIndentWidthForUsage = 4ZU;
 
+    namespace detail {
+
+        // 出力イテレータ `out` に `count` 個のスペースを書き込み、書き込み終えた位置を返す。
+        template <std::output_iterator<char> O>
+        constexpr O write_padding(O out, std::size_t count)
+        {
+            return std::ranges::fill_n(std::move(out), static_cast<std::iter_difference_t<O>>(count), ' ');
+        }
+
+    } // namespace detail
+
     
     namespace detail {
 
@@ -566,6 +1289,9 @@ namespace col {
 
         D m_default_value;
         P m_value_parser;
+        char m_delimiter;
+        // 短いオプション名。 `'\0'` であれば持たない。
+        char m_short_name;
     public:
         // このコマンドライン引数に対応する型。
         using value_type = T;
@@ -580,17 +1306,21 @@ namespace col {
         , m_help{ help }
         , m_default_value{}
         , m_value_parser{}
+        , m_delimiter{ ',' }
+        , m_short_name{ '\0' }
         {}
 
     private:
         template <class De, class Pr>
         requires (std::is_object_v<std::decay_t<De>> && std::is_object_v<std::decay_t<Pr>>)
-        constexpr explicit Arg(OptionName name, std::string_view help, De&& de, Pr&& p)
+        constexpr explicit Arg(OptionName name, std::string_view help, De&& de, Pr&& p, char delimiter, char short_name)
             noexcept (std::is_nothrow_constructible_v<D, De> && std::is_nothrow_constructible_v<P, Pr>)
         : m_name{ name }
         , m_help{ help }
         , m_default_value{ std::forward<De>(de) }
         , m_value_parser{ std::forward<Pr>(p) }
+        , m_delimiter{ delimiter }
+        , m_short_name{ short_name }
         {}
 
     public:
@@ -609,28 +1339,55 @@ namespace col {
         {
             return m_default_value;
         }
+        // 数値の列を区切る文字を得る
+        [[nodiscard]] constexpr char get_delimiter() const noexcept
+        {
+            return m_delimiter;
+        }
+        // 短いオプション名を得る。持たない場合は `'\0'` 。
+        [[nodiscard]] constexpr char get_short_name() const noexcept
+        {
+            return m_short_name;
+        }
 
         // usage 文字列を得る。
         // `indent_width` はインデント幅、 `help_column` はヘルプメッセージが開始される行頭からの位置。
-        [[nodiscard]] constexpr std::string get_usage(std::size_t indent_with, std::size_t help_column) const
+        [[nodiscard]] constexpr std::string get_usage(std::size_t indent_width, std::size_t help_column) const
         {
             std::string usage{};
             usage.reserve(help_column + m_help.size());
-            usage.append(indent_with, ' ');
-            usage += "--";
-            usage += m_name;
+            write_usage(std::back_inserter(usage), indent_width, help_column);
+            return usage;
+        }
+
+        // usage 文字列を出力イテレータ `out` に書き込み、書き込み終えた位置を返す。
+        // `indent_width` はインデント幅、 `help_column` はヘルプメッセージが開始される行頭からの位置。
+        template <std::output_iterator<char> O>
+        constexpr O write_usage(O out, std::size_t indent_width, std::size_t help_column) const
+        {
+            std::size_t column = indent_width + 2ZU + m_name.size();
+            out = detail::write_padding(std::move(out), indent_width);
+            if( m_short_name != '\0' )
+            {
+                *out++ = '-';
+                *out++ = m_short_name;
+                out = std::ranges::copy(std::string_view{", "}, std::move(out)).out;
+                column += 4ZU;
+            }
+            out = std::ranges::copy(std::string_view{"--"}, std::move(out)).out;
+            out = std::ranges::copy(m_name, std::move(out)).out;
             if constexpr( !std::same_as<T, blank> && !std::same_as<T, bool> )
             {
-                usage += " <";
-                usage.append_range(m_name | std::ranges::views::transform([](char c) static noexcept
+                out = std::ranges::copy(std::string_view{" <"}, std::move(out)).out;
+                out = std::ranges::copy(m_name | std::ranges::views::transform([](char c) static noexcept
                     {
-                        return ('A' <= c && c <= 'Z') ? static_cast<char>(c - ('a' - 'A')) : c;
-                    }));
-                usage += '>';
+                        return ('a' <= c && c <= 'z') ? static_cast<char>(c - ('a' - 'A')) : c;
+                    }), std::move(out)).out;
+                *out++ = '>';
+                column += m_name.size() + 3ZU;
             }
-            usage.append(help_column - usage.size(), ' ');
-            usage += m_help;
-            return usage;
+            out = detail::write_padding(std::move(out), help_column > column ? help_column - column : 0ZU);
+            return std::ranges::copy(m_help, std::move(out)).out;
         }
 
         // `T` の値を明示的に設定する。
@@ -652,7 +1409,9 @@ namespace col {
                 m_name,
                 m_help,
                 std::move(m_default_value),
-                std::move(m_value_parser)
+                std::move(m_value_parser),
+                m_delimiter,
+                m_short_name
             };
         }
 
@@ -689,12 +1448,15 @@ namespace col {
                 m_name,
                 m_help,
                 std::forward<De>(de),
-                std::move(m_value_parser)
+                std::move(m_value_parser),
+                m_delimiter,
+                m_short_name
             };
         }
 
         // パーサーを設定する。
-        // `P` は、`const char*` を引数として呼び出せる呼び出し可能オブジェクトでなければならない。
+        // `P` は、`std::string_view` または `const char*` を引数として呼び出せる呼び出し可能オブジェクトでなければならない。
+        // 両方で呼び出せる場合は `std::string_view` で呼び出される。
         // `T` が `col::blank` の場合は、 `De` および `P` の型をもとに `T` が推論される。
         // 
         // `P` が `col::blank` でなければならない。
@@ -726,7 +1488,9 @@ namespace col {
                 m_name,
                 m_help,
                 std::move(m_default_value),
-                std::forward<Pr>(p)
+                std::forward<Pr>(p),
+                m_delimiter,
+                m_short_name
             };
         }
 
@@ -769,7 +1533,41 @@ namespace col {
                 m_name,
                 m_help,
                 std::move(m_default_value),
-                PossibleValueParser(std::forward<Pr>(pr))
+                PossibleValueParser(std::forward<Pr>(pr)),
+                m_delimiter,
+                m_short_name
+            };
+        }
+
+        // 数値の列を区切る文字を設定する。既定値は `,` 。
+        //
+        // `T` が `col::number_list_type` でなければならない。
+        constexpr Arg set_delimiter(char delimiter) &&
+            noexcept (std::is_nothrow_move_constructible_v<D> && std::is_nothrow_move_constructible_v<P>)
+            requires (number_list_type<T>)
+        {
+            return Arg{
+                m_name,
+                m_help,
+                std::move(m_default_value),
+                std::move(m_value_parser),
+                delimiter,
+                m_short_name
+            };
+        }
+
+        // 短いオプション名を設定する。 `-v` のように指定でき、値を取らないオプションは `-xvf` のようにまとめて指定できる。
+        // 値を取るオプションの値は、 `-n 5` のように次のトークンとしても、 `-n5` のように続けても指定できる。
+        constexpr Arg set_short_name(ShortOptionName short_name) &&
+            noexcept (std::is_nothrow_move_constructible_v<D> && std::is_nothrow_move_constructible_v<P>)
+        {
+            return Arg{
+                m_name,
+                m_help,
+                std::move(m_default_value),
+                std::move(m_value_parser),
+                m_delimiter,
+                short_name
             };
         }
 
@@ -789,12 +1587,12 @@ namespace col {
                     std::same_as<T, bool> || std::is_integral_v<T> || std::is_floating_point_v<T>
                 ) ||
                 (
-                    !std::invocable<P, const char*> &&
+                    std::same_as<P, blank> &&
                     std::is_nothrow_convertible_v<const char*, T>
                 ) ||
                 requires {
-                    typename std::invoke_result_t<P, const char*>;
-                    std::is_nothrow_convertible_v<typename std::invoke_result_t<P, const char*>, T>;
+                    typename value_parser_result_t<P>;
+                    std::is_nothrow_convertible_v<value_parser_result_t<P>, T>;
                 }
             )
             requires (!std::same_as<T, blank> && !is_col_deduced_v<T>)
@@ -815,85 +1613,237 @@ namespace col {
                 if( iter == s )
                 {
                     return std::unexpected{
-                        col::MissingOptionValue {
-                            .name = m_name,
-                        }
+                        col::ParseError{ col::ParseErrorKind::MissingOptionValue }
                     };
                 }
                 const std::string_view a{ *iter };
                 std::ranges::advance(iter, 1);
 
-                if constexpr( std::invocable<P, const char*> )
+                if constexpr( async_value_parser_type<P> )
+                {
+                    // 1 つずつパースする場合は、その場で完了を待つ
+                    return from_parser_result(col::sync_wait(invoke_value_parser(a)), a);
+                }
+                else if constexpr( value_parser_type<P> )
+                {
+                    return from_parser_result(invoke_value_parser(a), a);
+                }
+                else if constexpr( std::convertible_to<const char*, T> )
                 {
-                    const auto res = std::invoke(m_value_parser, a.data());
-                    using R = std::remove_cvref_t<decltype(res)>;
-                    if constexpr( std::same_as<R, T> )
+                    // `std::string_view` から構築できる型は、既知の長さを使って構築する
+                    if constexpr( std::constructible_from<T, std::string_view> )
                     {
-                        return std::move(res);
+                        return T(a);
                     }
-                    else if constexpr( col::is_std_optional_v<R> )
+                    else
                     {
-                        if( res.has_value() )
-                        {
-                            return std::move(*res);
-                        }
-                        else
-                        {
-                            return std::unexpected{
-                                col::ValueParserError{
-                                    .name = m_name,
-                                    .arg = a,
-                                }
-                            };
-                        }
+                        return static_cast<T>(a.data());
+                    }
+                }
+                else if constexpr( std::is_integral_v<T> || std::is_floating_point_v<T> )
+                {
+                    const auto res = col::number_from_string<T>(a);
+                    if( res.has_value() )
+                    {
+                        return *res;
+                    }
+                    else
+                    {
+                        return std::unexpected{
+                            col::ParseError{ col::ParseErrorKind::InvalidNumber, a, static_cast<std::uint8_t>(res.error().ec) }
+                        };
+                    }
+                }
+                else if constexpr( number_list_type<T> )
+                {
+                    // 要素数を先に数え、 `std::vector` は一度だけ確保し、 `std::array` は長さを検査する
+                    const auto size = col::number_list_size(a, m_delimiter);
+                    T values{};
+                    if constexpr( is_std_vector_v<T> )
+                    {
+                        values.reserve(size);
+                    }
+                    else if( size != values.size() )
+                    {
+                        // 期待した要素数と実際の要素数は、 `explain` で型とトークンから求め直す
+                        return std::unexpected{
+                            col::ParseError{ col::ParseErrorKind::InvalidListLength, a }
+                        };
                     }
-                    else if constexpr( col::is_std_expected_v<R> )
+                    const auto res = [&]()
                     {
-                        if( res.has_value() )
+                        if constexpr( is_std_vector_v<T> )
                         {
-                            return std::move(*res);
+                            return col::number_list_from_string<typename T::value_type>(a, m_delimiter, std::back_inserter(values));
                         }
                         else
                         {
-                            return std::unexpected{
-                                std::move(res.error())
-                            };
+                            return col::number_list_from_string<typename T::value_type>(a, m_delimiter, values.begin());
                         }
-                    }
-                }
-                else if constexpr( std::convertible_to<const char*, T> )
-                {
-                    return static_cast<T>(a.data());
-                }
-                else if constexpr( std::is_integral_v<T> || std::is_floating_point_v<T> )
-                {
-                    const auto res = col::number_from_string<T>(a);
+                    }();
                     if( res.has_value() )
                     {
-                        return *res;
+                        return values;
                     }
                     else
                     {
                         return std::unexpected{
-                            col::InvalidNumber{
-                                .name = m_name,
-                                .arg = a,
-                                .err = std::move(res).error().ec,
-                            }
+                            col::ParseError{ col::ParseErrorKind::InvalidNumber, res.error().element, static_cast<std::uint8_t>(res.error().result.ec) }
                         };
                     }
                 }
                 else
                 {
                     return std::unexpected{
-                        col::InvalidConfiguration{
-                            .name =  m_name,
-                            .kind = col::InvalidConfigKind::EmptyParser,
-                        }
+                        col::ParseError{ col::ParseErrorKind::InvalidConfiguration, {}, static_cast<std::uint8_t>(col::InvalidConfigKind::EmptyParser) }
+                    };
+                }
+            }
+        }
+
+        // 非同期のパーサーでコマンドライン引数の文字列 `a` をパースし、結果を `value` に格納するタスクを生成する。
+        // 失敗した場合は、エラーの位置を `site` としたそのエラーを結果とする。
+        //
+        // `a` の指す文字列と `value` は、タスクが完了するまで生存していなければならない。
+        [[nodiscard]] col::Task<std::optional<col::ParseError>> parse_async(std::string_view a, std::optional<T>& value, std::size_t site) const
+            requires (async_value_parser_type<P>)
+        {
+            auto res = from_parser_result(co_await invoke_value_parser(a), a);
+            if( res.has_value() )
+            {
+                value.emplace(std::move(*res));
+                co_return std::nullopt;
+            }
+            co_return std::move(res).error().at_site(site);
+        }
+
+        // コマンドライン引数の文字列 `a` をパーサーに渡す。
+        // `const char*` を取るパーサーには `a.data()` を渡すため、 `a` は終端文字で終わっていなければならない。
+        constexpr decltype(auto) invoke_value_parser(std::string_view a) const
+            requires (value_parser_type<P>)
+        {
+            if constexpr( std::same_as<value_parser_argument_t<P>, const char*> )
+            {
+                return std::invoke(m_value_parser, a.data());
+            }
+            else
+            {
+                return std::invoke(m_value_parser, a);
+            }
+        }
+
+        // パーサーの戻り値 `res` を、コマンドライン引数の文字列 `a` をパースした結果に変換する。
+        template <class R>
+        [[nodiscard]] constexpr std::expected<T, col::ParseError> from_parser_result(R res, std::string_view a) const
+        {
+            if constexpr( std::same_as<R, T> )
+            {
+                return std::move(res);
+            }
+            else if constexpr( col::is_std_optional_v<R> )
+            {
+                if( res.has_value() )
+                {
+                    return std::move(*res);
+                }
+                else
+                {
+                    return std::unexpected{
+                        col::ParseError{ col::ParseErrorKind::ValueParserError, a }
+                    };
+                }
+            }
+            else if constexpr( col::is_std_expected_v<R> )
+            {
+                if( res.has_value() )
+                {
+                    return std::move(*res);
+                }
+                else
+                {
+                    return std::unexpected{
+                        std::move(res.error())
                     };
                 }
             }
         }
+
+        // このオプションで生じたエラー `err` の詳細を復元する。 `index` はコマンドにおけるこのオプションのインデックス。
+        [[nodiscard]] constexpr col::ParseErrorDetail explain(const col::ParseError& err, std::size_t index) const noexcept
+        {
+            switch( err.kind() )
+            {
+                case col::ParseErrorKind::InternalLogicError:
+                    return col::InternalLogicError{
+                        .name = m_name,
+                        .kind = static_cast<col::InternalLogicErrorKind>(err.detail()),
+                    };
+                case col::ParseErrorKind::DuplicateOption:
+                    return col::DuplicateOption{
+                        .name = m_name,
+                    };
+                case col::ParseErrorKind::MissingOptionValue:
+                    return col::MissingOptionValue{
+                        .name = m_name,
+                    };
+                case col::ParseErrorKind::UnexpectedOptionValue:
+                    return col::UnexpectedOptionValue{
+                        .name = m_name,
+                        .arg = err.token(),
+                    };
+                case col::ParseErrorKind::ValueParserError:
+                    return col::ValueParserError{
+                        .name = m_name,
+                        .arg = err.token(),
+                    };
+                case col::ParseErrorKind::DefaultValueError:
+                    return col::DefaultValueError{
+                        .name = m_name,
+                    };
+                case col::ParseErrorKind::InvalidNumber:
+                    return col::InvalidNumber{
+                        .name = m_name,
+                        .arg = err.token(),
+                        .err = static_cast<std::errc>(err.detail()),
+                    };
+                case col::ParseErrorKind::InvalidListLength:
+                    {
+                        // 要素数が合わないのは固定長の列だけ
+                        std::uint32_t expected = 0U;
+                        if constexpr( is_std_array_v<T> )
+                        {
+                            expected = static_cast<std::uint32_t>(std::tuple_size_v<T>);
+                        }
+                        return col::InvalidListLength{
+                            .name = m_name,
+                            .arg = err.token(),
+                            .expected = expected,
+                            .actual = static_cast<std::uint32_t>(col::number_list_size(err.token(), m_delimiter)),
+                        };
+                    }
+                case col::ParseErrorKind::NotEnoughArgument:
+                    return col::NotEnoughArgument{
+                        .index = index,
+                        .name = m_name,
+                    };
+                case col::ParseErrorKind::InvalidConfiguration:
+                    return col::InvalidConfiguration{
+                        .name = m_name,
+                        .kind = static_cast<col::InvalidConfigKind>(err.detail()),
+                    };
+                case col::ParseErrorKind::MissingRequiredOption:
+                    return col::MissingRequiredOption{
+                        .name = m_name,
+                    };
+                case col::ParseErrorKind::UnknownError:
+                case col::ParseErrorKind::UnknownOption:
+                case col::ParseErrorKind::AmbiguousOption:
+                case col::ParseErrorKind::ShowHelp:
+                    // オプションではなくコマンドで生じるエラー
+                    break;
+            }
+            return col::UnknownError{};
+        }
     };
 
     // 推論ガイド。
@@ -968,23 +1918,397 @@ namespace col {
         using next_cmd_type_t = next_cmd_type<CmdT, T>::type;
 
 
-        template <class T, class, class>
-        class CmdBase;
-        template <class T, class ...SubCmdTypes, class ...ArgTypes>
-        class CmdBase<T, std::tuple<SubCmdTypes...>, std::tuple<ArgTypes...>>
+        // `get_name()` を持つ要素からなる tuple から `NameIndexTable` を生成する。
+        template <class ...Ts>
+        [[nodiscard]] constexpr NameIndexTable<sizeof...(Ts)> make_name_index_table(const std::tuple<Ts...>& t) noexcept
         {
-            const std::string_view m_name;
-            const std::string_view m_help;
-            std::tuple<SubCmdTypes...> m_subs;
-            std::tuple<ArgTypes...> m_args;
+            return std::apply([](const Ts& ...ts) noexcept
+                {
+                    return NameIndexTable<sizeof...(Ts)>{
+                        std::array<std::string_view, sizeof...(Ts)>{ ts.get_name()... }
+                    };
+                }, t);
+        }
+
+        // `NamePrefixTrie::find` の結果の種類。
+        enum class NamePrefixMatchKind : std::uint8_t
+        {
+            // 一致する名前がない。
+            NotFound,
+            // 名前と完全に一致した。
+            Exact,
+            // 1 つの名前の前置きとして一意に一致した。
+            Prefix,
+            // 複数の名前の前置きとして一致した。
+            Ambiguous,
+        };
+
+        // `NamePrefixTrie::find` の結果。
+        struct NamePrefixMatch
+        {
+            NamePrefixMatchKind kind;
+            // `kind` が `Exact` または `Prefix` の場合の要素のインデックス。
+            std::size_t index;
+        };
+
+        // 名前またはその前置きから要素のインデックスを引く、要素数 `N` の基数木 (radix trie)。
+        //
+        // 各辺のラベルは登録された名前の部分文字列を指し、ノード数は高々 `2 * N + 1` に収まる。
+        // 各ノードは、部分木に含まれる名前が 1 つだけであればそのインデックスを保持するため、
+        // 完全一致・一意な前置き・曖昧な前置きのいずれもトークンの長さに比例する時間で判定できる。
+        // Cmd, SubCmd の構築時にオプション名から生成される。 `constexpr` なコマンドではコンパイル時に生成される。
+        // 同じ名前が複数ある場合は、先に登録された要素のインデックスが引かれる。
+        template <std::size_t N>
+        class NamePrefixTrie
+        {
+            using index_type = std::uint16_t;
+            static_assert(N * 2ZU + 1ZU < 0xFFFEZU, "too many names for a single command");
+
+            static constexpr std::size_t MaxNodes = N * 2ZU + 1ZU;
+            // 該当するノードや要素がない。
+            static constexpr index_type None = 0xFFFF;
+            // 部分木に複数の名前が含まれる。
+            static constexpr index_type Many = 0xFFFE;
+
+            struct Node
+            {
+                // 親ノードからこのノードへの辺のラベル。
+                std::string_view label;
+                index_type first_child;
+                index_type next_sibling;
+                // ちょうどこのノードで終わる名前のインデックス。
+                index_type terminal;
+                // 部分木に含まれる名前が 1 つだけであればそのインデックス、複数あれば `Many` 。
+                index_type unique;
+            };
+
+            std::array<std::string_view, N> m_names;
+            std::array<Node, MaxNodes> m_nodes;
+            std::size_t m_size;
+
+            // ノード `node` の子のうち、ラベルが文字 `c` で始まるものを得る。
+            [[nodiscard]] constexpr index_type child_starting_with(index_type node, char c) const noexcept
+            {
+                for( auto child = m_nodes[node].first_child; child != None; child = m_nodes[child].next_sibling )
+                {
+                    if( m_nodes[child].label.front() == c )
+                    {
+                        return child;
+                    }
+                }
+                return None;
+            }
+
+            // 名前 `name` をインデックス `index` として登録する。
+            constexpr void insert(std::string_view name, index_type index) noexcept
+            {
+                index_type node = 0;
+                std::size_t pos = 0ZU;
+                while( true )
+                {
+                    auto& current = m_nodes[node];
+                    current.unique = current.unique == None ? index : Many;
+                    if( pos == name.size() )
+                    {
+                        current.terminal = index;
+                        return;
+                    }
+                    const auto child = child_starting_with(node, name[pos]);
+                    if( child == None )
+                    {
+                        const auto leaf = static_cast<index_type>(m_size++);
+                        m_nodes[leaf] = Node{
+                            .label = name.substr(pos),
+                            .first_child = None,
+                            .next_sibling = current.first_child,
+                            .terminal = index,
+                            .unique = index,
+                        };
+                        current.first_child = leaf;
+                        return;
+                    }
+                    const auto rest = name.substr(pos);
+                    const auto label = m_nodes[child].label;
+                    const auto common = static_cast<std::size_t>(std::ranges::mismatch(label, rest).in1 - label.begin());
+                    if( common < label.size() )
+                    {
+                        // 辺の途中で分かれるため、 `child` を共通部分のノードとし、残りを新しい子ノードに移す
+                        const auto suffix = static_cast<index_type>(m_size++);
+                        m_nodes[suffix] = Node{
+                            .label = label.substr(common),
+                            .first_child = m_nodes[child].first_child,
+                            .next_sibling = None,
+                            .terminal = m_nodes[child].terminal,
+                            .unique = m_nodes[child].unique,
+                        };
+                        m_nodes[child].label = label.substr(0ZU, common);
+                        m_nodes[child].first_child = suffix;
+                        m_nodes[child].terminal = None;
+                    }
+                    node = child;
+                    pos += common;
+                }
+            }
+
+        public:
+            constexpr explicit NamePrefixTrie(const std::array<std::string_view, N>& names) noexcept
+            : m_names{ names }
+            , m_nodes{}
+            , m_size{ 1ZU }
+            {
+                m_nodes[0] = Node{
+                    .label = {},
+                    .first_child = None,
+                    .next_sibling = None,
+                    .terminal = None,
+                    .unique = None,
+                };
+                for( std::size_t i = 0ZU; i < N; ++i )
+                {
+                    if( const auto res = find(m_names[i]); res.kind != NamePrefixMatchKind::Exact )
+                    {
+                        insert(m_names[i], static_cast<index_type>(i));
+                    }
+                }
+            }
+
+            // 名前またはその前置き `prefix` に一致する要素を引く。
+            // 空の文字列はどの名前にも一致しない。
+            [[nodiscard]] constexpr NamePrefixMatch find(std::string_view prefix) const noexcept
+            {
+                index_type node = 0;
+                std::size_t pos = 0ZU;
+                bool inside_edge = false;
+                while( pos < prefix.size() )
+                {
+                    const auto child = child_starting_with(node, prefix[pos]);
+                    if( child == None )
+                    {
+                        return { NamePrefixMatchKind::NotFound, 0ZU };
+                    }
+                    const auto rest = prefix.substr(pos);
+                    const auto label = m_nodes[child].label;
+                    if( rest.size() < label.size() )
+                    {
+                        if( !label.starts_with(rest) )
+                        {
+                            return { NamePrefixMatchKind::NotFound, 0ZU };
+                        }
+                        inside_edge = true;
+                    }
+                    else if( !rest.starts_with(label) )
+                    {
+                        return { NamePrefixMatchKind::NotFound, 0ZU };
+                    }
+                    node = child;
+                    pos += label.size();
+                }
+                const auto& found = m_nodes[node];
+                if( node == 0 )
+                {
+                    return { NamePrefixMatchKind::NotFound, 0ZU };
+                }
+                if( !inside_edge && found.terminal != None )
+                {
+                    return { NamePrefixMatchKind::Exact, found.terminal };
+                }
+                if( found.unique == Many )
+                {
+                    return { NamePrefixMatchKind::Ambiguous, 0ZU };
+                }
+                return { NamePrefixMatchKind::Prefix, found.unique };
+            }
+
+            // 登録された名前を登録順に得る。
+            [[nodiscard]] constexpr const std::array<std::string_view, N>& names() const noexcept
+            {
+                return m_names;
+            }
+        };
+
+        // `get_name()` を持つ要素からなる tuple から `NamePrefixTrie` を生成する。
+        template <class ...Ts>
+        [[nodiscard]] constexpr NamePrefixTrie<sizeof...(Ts)> make_name_prefix_trie(const std::tuple<Ts...>& t) noexcept
+        {
+            return std::apply([](const Ts& ...ts) noexcept
+                {
+                    return NamePrefixTrie<sizeof...(Ts)>{
+                        std::array<std::string_view, sizeof...(Ts)>{ ts.get_name()... }
+                    };
+                }, t);
+        }
+
+        // 短いオプション名の文字から要素のインデックスを引く、文字の値で直接引く 256 要素の表。
+        //
+        // Cmd, SubCmd の構築時に生成される。同じ短いオプション名が複数ある場合は、先に登録された要素のインデックスが引かれる。
+        class ShortNameIndexTable
+        {
+            // 文字の値ごとに、要素のインデックスに 1 を加えた値。 0 であれば該当する要素はない。
+            std::array<std::uint16_t, 256ZU> m_table;
+        public:
+            // `names` の各要素を短いオプション名として登録する。 `'\0'` の要素は登録しない。
+            template <std::size_t N>
+            constexpr explicit ShortNameIndexTable(const std::array<char, N>& names) noexcept
+            : m_table{}
+            {
+                static_assert(N < 0xFFFFZU, "too many options");
+                for( std::size_t i = N; i > 0ZU; --i )
+                {
+                    if( names[i - 1ZU] != '\0' )
+                    {
+                        m_table[static_cast<unsigned char>(names[i - 1ZU])] = static_cast<std::uint16_t>(i);
+                    }
+                }
+            }
+
+            // 短いオプション名 `c` を持つ要素のインデックスを引く。
+            [[nodiscard]] constexpr std::optional<std::size_t> find(char c) const noexcept
+            {
+                const std::uint16_t entry = m_table[static_cast<unsigned char>(c)];
+                if( entry == 0U )
+                {
+                    return std::nullopt;
+                }
+                return static_cast<std::size_t>(entry - 1U);
+            }
+        };
+
+        // `get_short_name()` を持つ要素からなる tuple から `ShortNameIndexTable` を生成する。
+        template <class ...Ts>
+        [[nodiscard]] constexpr ShortNameIndexTable make_short_name_index_table(const std::tuple<Ts...>& t) noexcept
+        {
+            return std::apply([](const Ts& ...ts) noexcept
+                {
+                    return ShortNameIndexTable{
+                        std::array<char, sizeof...(Ts)>{ ts.get_short_name()... }
+                    };
+                }, t);
+        }
+
+        // コマンドライン引数の走査中に変換せず、後回しにするオプションの種類。
+        enum class DeferKind : std::uint32_t
+        {
+            // `col::Task` を返す非同期のパーサーを持つオプション。
+            AsyncParser,
+            // 値を取るすべてのオプション。
+            Value,
+        };
+
+        // 後回しにしたオプション 1 つについて、値の変換またはデフォルト値の生成を行う処理。
+        // `cmd` はそのオプションを持つコマンド、 `state` はそのコマンドの途中状態を指す。
+        // `site` は、ルートのコマンドから見た `cmd` のエラーの位置。
+        struct DeferredJob
+        {
+            std::optional<col::ParseError> (*run)(const void* cmd, void* state);
+            const void* cmd;
+            void* state;
+            std::size_t site;
+        };
+
+        // `jobs` を最大 `threads` 個のスレッドで分担して実行し、それぞれの結果を `jobs` と同じ順に並べて返す。
+        // エラーの位置はルートのコマンドから見た位置に直す。
+        // 呼び出したスレッドも処理を分担し、すべての処理が終わるまで戻らない。
+        inline std::vector<std::optional<col::ParseError>> run_deferred_jobs(std::span<const DeferredJob> jobs, std::size_t threads)
+        {
+            std::vector<std::optional<col::ParseError>> results(jobs.size());
+            std::atomic<std::size_t> next{ 0ZU };
+            const auto work = [&]() noexcept
+                {
+                    for( auto i = next.fetch_add(1ZU, std::memory_order_relaxed); i < jobs.size(); i = next.fetch_add(1ZU, std::memory_order_relaxed) )
+                    {
+                        if( auto res = jobs[i].run(jobs[i].cmd, jobs[i].state); res.has_value() )
+                        {
+                            results[i] = res->shift_site(jobs[i].site);
+                        }
+                    }
+                };
+            {
+                const auto count = std::min(threads, jobs.size());
+                std::vector<std::jthread> workers{};
+                workers.reserve(count > 1ZU ? count - 1ZU : 0ZU);
+                for( std::size_t i = 1ZU; i < count; ++i )
+                {
+                    workers.emplace_back(work);
+                }
+                work();
+            }
+            return results;
+        }
+
+
+        template <class T, class, class>
+        class CmdBase;
+        template <class T, class ...SubCmdTypes, class ...ArgTypes>
+        class CmdBase<T, std::tuple<SubCmdTypes...>, std::tuple<ArgTypes...>>
+        {
+            const std::string_view m_name;
+            const std::string_view m_help;
+            std::tuple<SubCmdTypes...> m_subs;
+            std::tuple<ArgTypes...> m_args;
+            // サブコマンド名から `m_subs` のインデックスを引くテーブル。
+            NameIndexTable<sizeof...(SubCmdTypes)> m_sub_index;
+            // オプション名またはその前置きから `m_args` のインデックスを引く基数木。
+            NamePrefixTrie<sizeof...(ArgTypes)> m_arg_trie;
+            // 短いオプション名から `m_args` のインデックスを引く表。
+            ShortNameIndexTable m_short_index;
+            // オプションの値の変換に用いるスレッド数。 1 以下であれば、走査しながら 1 つずつ変換する。
+            std::size_t m_parallelism;
+
+            // サブコマンドのパース結果。
+            using SubCmdVariantType = std::variant<std::monostate, typename SubCmdTypes::value_type...>;
+            // 各オプションのパース結果。
+            using ParsedArguments = std::tuple<std::optional<typename ArgTypes::value_type>...>;
+            // 各オプションが `col::Task` を返す非同期のパーサーを持つかどうか。
+            static constexpr std::array<bool, sizeof...(ArgTypes)> is_async_arg{ async_value_parser_type<typename ArgTypes::parser_type>... };
+            // 各オプションが値を取るかどうか。
+            static constexpr std::array<bool, sizeof...(ArgTypes)> takes_value{ !std::same_as<typename ArgTypes::value_type, bool>... };
+
+            // `ShowHelp` はサブコマンドのインデックスを 1 バイトで保持する。
+            static_assert(sizeof...(SubCmdTypes) <= 0xFFZU, "too many subcommands for a single command");
+
+        public:
+            // このコマンドを含むコマンドの入れ子の深さ。
+            static constexpr std::size_t depth = std::max({ 0ZU, SubCmdTypes::depth... }) + 1ZU;
+            // このコマンドを根とする部分木のエラーの位置の数。
+            // このコマンド自身、各オプション、各サブコマンドの部分木の順に位置を数える。
+            static constexpr std::size_t error_site_count = 1ZU + sizeof...(ArgTypes) + (0ZU + ... + SubCmdTypes::error_site_count);
+
+        private:
+            // `ParseError` はエラーの位置を 2 バイトで保持する。
+            static_assert(error_site_count <= 0x10000ZU, "too many options and subcommands");
+
+            // 各サブコマンドの部分木の先頭の、このコマンドから見たエラーの位置。
+            static constexpr std::array<std::size_t, sizeof...(SubCmdTypes)> sub_error_sites = []()
+                {
+                    constexpr std::array<std::size_t, sizeof...(SubCmdTypes)> counts{ SubCmdTypes::error_site_count... };
+                    std::array<std::size_t, sizeof...(SubCmdTypes)> sites{};
+                    std::size_t next = 1ZU + sizeof...(ArgTypes);
+                    for( std::size_t i = 0ZU; i < counts.size(); ++i )
+                    {
+                        sites[i] = next;
+                        next += counts[i];
+                    }
+                    return sites;
+                }();
+
+            // `index` 番目のオプションのエラーの位置。
+            static constexpr std::size_t option_site(std::size_t index) noexcept
+            {
+                return index + 1ZU;
+            }
 
         public:
+
             constexpr CmdBase(std::string_view name, std::string_view help) noexcept
                 requires (sizeof...(SubCmdTypes) == 0 && sizeof...(ArgTypes) == 0)
             : m_name{ name }
             , m_help{ help }
             , m_subs{}
             , m_args{}
+            , m_sub_index{ {} }
+            , m_arg_trie{ {} }
+            , m_short_index{ std::array<char, 0ZU>{} }
+            , m_parallelism{ 0ZU }
             {}
 
             constexpr std::string_view get_name() const noexcept
@@ -997,10 +2321,16 @@ namespace col {
                 return m_help;
             }
 
+            // オプションの値の変換に用いるスレッド数を得る。
+            constexpr std::size_t get_parallelism() const noexcept
+            {
+                return m_parallelism;
+            }
+
         protected:
             constexpr CmdBase(
                 std::string_view name, std::string_view help,
-                std::tuple<SubCmdTypes...>&& subs, std::tuple<ArgTypes...>&& args)
+                std::tuple<SubCmdTypes...>&& subs, std::tuple<ArgTypes...>&& args, std::size_t parallelism)
                 noexcept(
                     std::is_nothrow_move_constructible_v<std::tuple<SubCmdTypes...>> &&
                     std::is_nothrow_move_constructible_v<std::tuple<ArgTypes...>>
@@ -1009,36 +2339,54 @@ namespace col {
             , m_help{ help }
             , m_subs{ std::move(subs) }
             , m_args{ std::move(args) }
+            , m_sub_index{ make_name_index_table(m_subs) }
+            , m_arg_trie{ make_name_prefix_trie(m_args) }
+            , m_short_index{ make_short_name_index_table(m_args) }
+            , m_parallelism{ parallelism }
             {}
 
-            [[nodiscard]] constexpr std::string get_usage_impl(std::string_view parent_cmd, std::size_t indent_width) const
+            [[nodiscard]] constexpr std::string get_usage_impl(const CommandPath& parent, std::size_t indent_width) const
+            {
+                std::string usage{};
+                write_usage_impl(std::back_inserter(usage), parent, indent_width);
+                return usage;
+            }
+
+            // usage 文字列を出力イテレータ `out` に書き込み、書き込み終えた位置を返す。
+            template <std::output_iterator<char> O>
+            constexpr O write_usage_impl(O out, const CommandPath& parent, std::size_t indent_width) const
             {
-                std::string usage{m_help};
+                const auto write = [&out](std::string_view str)
+                    {
+                        out = std::ranges::copy(str, std::move(out)).out;
+                    };
+
+                write(m_help);
 
                 // "Usage: cmd subcmd [OPTIONS] [COMMAND]"
-                usage += "\n\nUsage: ";
-                if( !parent_cmd.empty() ) // Cmd の場合は parent がない
+                write("\n\nUsage: ");
+                for( const auto parent_name : parent.names() ) // Cmd の場合は parent がない
                 {
-                    usage += parent_cmd;
-                    usage += ' ';
+                    write(parent_name);
+                    write(" ");
                 }
-                usage += m_name;
+                write(m_name);
                 if constexpr( sizeof...(ArgTypes) > 0 )
                 {
-                    usage += " [OPTIONS]";
+                    write(" [OPTIONS]");
                 }
                 if constexpr( sizeof...(SubCmdTypes) > 0 )
                 {
-                    usage += " [COMMAND]";
+                    write(" [COMMAND]");
                 }
-                usage += '\n';
+                write("\n");
 
                 // Options:
                 //    --name    help
                 //    --str     help
                 if constexpr( sizeof...(ArgTypes) > 0 )
                 {
-                    usage += "\nOptions:\n";
+                    write("\nOptions:\n");
                     std::size_t max_option_name_length = 0ZU;
                     tuple_foreach([&max_option_name_length]<class ArgT>(const ArgT& arg) noexcept
                         {
@@ -1047,6 +2395,10 @@ namespace col {
                             {
                                 length += length + 3; // `' '`, "<>"
                             }
+                            if( arg.get_short_name() != '\0' )
+                            {
+                                length += 4ZU; // "-x, "
+                            }
                             if( length > max_option_name_length )
                             {
                                 max_option_name_length = length;
@@ -1055,13 +2407,14 @@ namespace col {
                     const std::size_t help_indent = (indent_width * 2 + max_option_name_length + 2ZU); // <INDENT+1><`--`><option_name><INDENT><help>
                     tuple_foreach([&]<class ArgT>(const ArgT& arg)
                         {
-                            usage += arg.get_usage(indent_width, help_indent) + "\n";
+                            out = arg.write_usage(std::move(out), indent_width, help_indent);
+                            write("\n");
                         }, m_args);
                 }
 
                 if constexpr( sizeof...(SubCmdTypes) > 0 )
                 {
-                    usage += "\nCommands:\n";
+                    write("\nCommands:\n");
                     std::size_t max_cmd_name_length = 0ZU;
                     tuple_foreach([&](const auto& sub)
                         {
@@ -1074,15 +2427,156 @@ namespace col {
                     const std::size_t help_indent = (indent_width * 2 + max_cmd_name_length);
                     tuple_foreach([&]<class SubCmdT>(const SubCmdT& sub)
                         {
-                            usage.append(indent_width, ' ');
-                            usage += sub.get_name();
-                            usage.append(help_indent - indent_width - sub.get_name().size(), ' ');
-                            usage += sub.get_help();
-                            usage += '\n';
+                            out = detail::write_padding(std::move(out), indent_width);
+                            write(sub.get_name());
+                            out = detail::write_padding(std::move(out), help_indent - indent_width - sub.get_name().size());
+                            write(sub.get_help());
+                            write("\n");
                         }, m_subs);
                 }
 
-                return usage;
+                return out;
+            }
+
+            // `UnknownOption` の書式化の際に呼び出され、 `cmd` が指すこのコマンドのオプション名とサブコマンド名から `arg` に綴りの近い名前を探す。
+            static std::optional<col::NameSuggestion> suggest_name(const void* cmd, std::string_view arg) noexcept
+            {
+                const auto& self = *static_cast<const CmdBase*>(cmd);
+                return detail::suggest_name(arg, self.m_arg_trie.names(), self.m_sub_index.names());
+            }
+
+            // このコマンドのオプションとして解釈できなかったトークン `a` に対するエラーの詳細を生成する。
+            // 綴りの近い名前はここでは探さず、書式化の際に `suggest_name` で探す。
+            constexpr col::UnknownOption unknown_option(std::string_view a) const noexcept
+            {
+                col::UnknownOption err{
+                    .arg = a,
+                    .cmd = nullptr,
+                    .suggest = nullptr,
+                };
+                if !consteval
+                {
+                    err.cmd = this;
+                    err.suggest = &suggest_name;
+                }
+                return err;
+            }
+
+            // このコマンドから `path` をたどった先のコマンドの usage 文字列を `out` に直接書き込む。
+            std::format_context::iterator write_usage_at(std::span<const std::uint8_t> path, const CommandPath& parent, std::format_context::iterator out) const
+            {
+                if constexpr( sizeof...(SubCmdTypes) > 0 )
+                {
+                    if( !path.empty() )
+                    {
+                        const auto sub_parent = parent.push(get_name());
+                        return col::tuple_visit_at(path.front(),
+                            [&](const auto& sub) -> std::format_context::iterator
+                            {
+                                return sub.write_usage_at(path.subspan(1ZU), sub_parent, std::move(out));
+                            },
+                            m_subs);
+                    }
+                }
+                return write_usage_impl(std::move(out), parent, DefaultIndentWidthForUsage);
+            }
+
+            // `ShowHelp` の書式化の際に呼び出され、 `cmd` が指すこのコマンドから `path` をたどった先のコマンドの usage 文字列を `out` に直接書き込む。
+            static std::format_context::iterator render_usage(const void* cmd, std::span<const std::uint8_t> path, const CommandPath& parent, std::format_context::iterator out)
+            {
+                return static_cast<const CmdBase*>(cmd)->write_usage_at(path, parent, std::move(out));
+            }
+
+            // このコマンドで `--help` が指定されたことを示すエラーの詳細を生成する。
+            constexpr col::ShowHelp show_help() const noexcept
+            {
+                return col::ShowHelp{
+                    .cmd = this,
+                    .render = &render_usage,
+                    .path = {},
+                    .depth = 0,
+                };
+            }
+
+            // インデックス `index` のサブコマンドのパースで生じたエラー `err` を、このコマンドのエラーとする。
+            // エラーの位置を、このコマンドから見た位置に直す。
+            constexpr col::ParseError from_sub_error(std::size_t index, col::ParseError err) const noexcept
+            {
+                return err.shift_site(sub_error_sites[index]);
+            }
+
+            // このコマンドから見たエラーの位置 `site` で生じたエラー `err` の詳細を復元する。
+            constexpr col::ParseErrorDetail explain_impl(const col::ParseError& err, std::size_t site) const noexcept
+            {
+                if constexpr( sizeof...(SubCmdTypes) > 0 )
+                {
+                    if( site >= sub_error_sites[0] )
+                    {
+                        // `site` を含む部分木のサブコマンドに任せる
+                        std::size_t index = sizeof...(SubCmdTypes) - 1ZU;
+                        while( site < sub_error_sites[index] )
+                        {
+                            --index;
+                        }
+                        auto detail = col::tuple_visit_at(index,
+                            [&](const auto& sub) noexcept -> col::ParseErrorDetail
+                            {
+                                return sub.explain_impl(err, site - sub_error_sites[index]);
+                            },
+                            m_subs);
+                        // `ShowHelp` であれば、このコマンドからそのサブコマンドへたどるインデックスを `path` の先頭に加える
+                        if( auto* help = std::get_if<col::ShowHelp>(&detail) )
+                        {
+                            for( std::size_t i = help->depth; i > 0ZU; --i )
+                            {
+                                help->path[i] = help->path[i - 1ZU];
+                            }
+                            help->path[0] = static_cast<std::uint8_t>(index);
+                            ++help->depth;
+                            help->cmd = this;
+                            help->render = &render_usage;
+                        }
+                        return detail;
+                    }
+                }
+
+                switch( err.kind() )
+                {
+                    case col::ParseErrorKind::UnknownOption:
+                        return unknown_option(err.token());
+                    case col::ParseErrorKind::AmbiguousOption:
+                        return col::AmbiguousOption{
+                            .arg = err.token(),
+                        };
+                    case col::ParseErrorKind::ShowHelp:
+                        return show_help();
+                    case col::ParseErrorKind::UnknownError:
+                    case col::ParseErrorKind::InternalLogicError:
+                    case col::ParseErrorKind::DuplicateOption:
+                    case col::ParseErrorKind::MissingOptionValue:
+                    case col::ParseErrorKind::UnexpectedOptionValue:
+                    case col::ParseErrorKind::ValueParserError:
+                    case col::ParseErrorKind::DefaultValueError:
+                    case col::ParseErrorKind::InvalidNumber:
+                    case col::ParseErrorKind::InvalidListLength:
+                    case col::ParseErrorKind::NotEnoughArgument:
+                    case col::ParseErrorKind::InvalidConfiguration:
+                    case col::ParseErrorKind::MissingRequiredOption:
+                        // オプションで生じたエラーは、そのオプションの定義から復元する
+                        break;
+                }
+                if constexpr( sizeof...(ArgTypes) > 0 )
+                {
+                    if( site != 0ZU && site <= sizeof...(ArgTypes) )
+                    {
+                        return col::visit_index<sizeof...(ArgTypes)>(site - 1ZU,
+                            [&]<std::size_t Index>(std::integral_constant<std::size_t, Index>) noexcept -> col::ParseErrorDetail
+                            {
+                                return std::get<Index>(m_args).explain(err, Index);
+                            });
+                    }
+                }
+                return col::UnknownError{};
             }
 
             template <class BaseCmdType, class Value, class Default, class Parser>
@@ -1097,7 +2591,8 @@ namespace col {
                     m_name,
                     m_help,
                     std::move(m_subs),
-                    std::tuple_cat(std::move(m_args), std::tuple{ std::move(arg) })
+                    std::tuple_cat(std::move(m_args), std::tuple{ std::move(arg) }),
+                    m_parallelism
                 };
             }
             template <class BaseCmdType, class Default, class Parser>
@@ -1128,13 +2623,27 @@ namespace col {
                     m_name,
                     m_help,
                     std::tuple_cat(std::move(m_subs), std::tuple{ sub }),
-                    std::move(m_args)
+                    std::move(m_args),
+                    m_parallelism
+                };
+            }
+
+            template <class BaseCmdType>
+            constexpr BaseCmdType set_parallelism_impl(std::size_t parallelism) &&
+                noexcept (std::is_nothrow_move_constructible_v<BaseCmdType>)
+            {
+                return BaseCmdType{
+                    m_name,
+                    m_help,
+                    std::move(m_subs),
+                    std::move(m_args),
+                    parallelism
                 };
             }
 
             template <class Target = T, class I, class S>
             requires (std::sentinel_for<S, I>)
-            constexpr std::expected<Target, col::ParseError> parse_impl(std::string_view parent_cmd, I& iter, const S& sentinel) const
+            constexpr std::expected<Target, col::ParseError> parse_impl(I& iter, const S& sentinel) const
                 requires(
                     requires {
                         sizeof...(SubCmdTypes) > 0;
@@ -1146,272 +2655,844 @@ namespace col {
                     }
                 )
             {
-                using SubCmdVariantType = std::variant<std::monostate, typename SubCmdTypes::value_type...>;
                 std::optional<SubCmdVariantType> subcommand{};
-                std::tuple<std::optional<typename ArgTypes::value_type>...> parsed_arguments{};
+                ParsedArguments parsed_arguments{};
+
+                while( iter != sentinel )
+                {
+                    const std::string_view a{ *iter };
+
+                    // TODO: `--help` の自動定義を選択可能にする
+                    if( a == "--help" )
+                    {
+                        return std::unexpected{
+                            col::ParseError{ col::ParseErrorKind::ShowHelp, a }
+                        };
+                    }
+
+                    if constexpr( sizeof...(SubCmdTypes) > 0 )
+                    {
+                        if( !subcommand.has_value() )
+                        {
+                            if( const auto sub_index = m_sub_index.find(a); sub_index.has_value() )
+                            {
+                                std::ranges::advance(iter, 1);
+                                auto sub_res = col::tuple_visit_at(*sub_index,
+                                    [&]<class SubCmdT>(const SubCmdT& sub) -> std::expected<SubCmdVariantType, col::ParseError>
+                                    {
+                                        auto res = sub.parse_impl(iter, sentinel);
+                                        if( res.has_value() )
+                                        {
+                                            return SubCmdVariantType{ std::move(*res) };
+                                        }
+                                        else
+                                        {
+                                            return std::unexpected{
+                                                std::move(res).error()
+                                            };
+                                        }
+                                    },
+                                    m_subs);
+                                if( !sub_res.has_value() )
+                                {
+                                    return std::unexpected{
+                                        from_sub_error(*sub_index, std::move(sub_res).error())
+                                    };
+                                }
+                                subcommand.emplace(std::move(*sub_res));
+                                // サブサブコマンドがパース成功した。
+                                // 残りの引数を続けてこのサブコマンドの引数として解釈できるが直感的ではないので、
+                                // ここで break して残りの引数はエラーとする。
+                                break;
+                            }
+                        }
+                    }
+
+                    if constexpr( sizeof...(ArgTypes) > 0 )
+                    {
+                        auto matched = match_option(a, parsed_arguments);
+                        if( !matched.has_value() )
+                        {
+                            return std::unexpected{
+                                std::move(matched).error()
+                            };
+                        }
+                        if( matched->has_value() )
+                        {
+                            std::ranges::advance(iter, 1);
+                            if( const auto& [index, attached] = **matched; index.has_value() )
+                            {
+                                auto res = attached.has_value()
+                                    ? parse_option_from(*index, *attached, parsed_arguments)
+                                    : parse_option(*index, parsed_arguments, iter, sentinel);
+                                if( res.has_value() )
+                                {
+                                    return std::unexpected{
+                                        std::move(*res)
+                                    };
+                                }
+                            }
+                            continue;
+                        }
+                    }
+
+                    // どのサブサブコマンドでもオプションでもない
+                    return std::unexpected{
+                        col::ParseError{ col::ParseErrorKind::UnknownOption, a }
+                    };
+                }
+
+                if( iter != sentinel )
+                {
+                    return std::unexpected{
+                        col::ParseError{ col::ParseErrorKind::UnknownOption, *iter }
+                    };
+                }
+
+                return finish_impl<Target>(subcommand, parsed_arguments);
+            }
+
+            // `index` 番目のオプションの値を `[iter, sentinel)` からパースして `values` に格納する。
+            // 失敗した場合はそのエラーを返す。
+            template <class I, class S>
+            requires (std::sentinel_for<S, I>)
+            constexpr std::optional<col::ParseError> parse_option(std::size_t index, ParsedArguments& values, I& iter, const S& sentinel) const
+            {
+                // トークンごとに呼ばれるため、 `zip_tuples` で参照の tuple を作らずに同じ位置の要素を直接参照する
+                return col::visit_index<std::tuple_size_v<ParsedArguments>>(index,
+                    [&]<std::size_t Index>(std::integral_constant<std::size_t, Index>)
+                        -> std::optional<col::ParseError>
+                    {
+                        const auto& arg = std::get<Index>(m_args);
+                        auto& value = std::get<Index>(values);
+                        if( value.has_value() )
+                        {
+                            return col::ParseError{ col::ParseErrorKind::DuplicateOption }.at_site(option_site(Index));
+                        }
+                        auto parse_res = arg.parse(iter, sentinel);
+                        if( parse_res.has_value() )
+                        {
+                            value.emplace(std::move(*parse_res));
+                            return std::nullopt;
+                        }
+                        else
+                        {
+                            return std::move(parse_res).error().at_site(option_site(Index));
+                        }
+                    });
+            }
+
+            // `index` 番目のオプションの値を 1 つのトークン `token` からパースして `values` に格納する。
+            // 失敗した場合はそのエラーを返す。
+            constexpr std::optional<col::ParseError> parse_option_from(std::size_t index, std::string_view token, ParsedArguments& values) const
+            {
+                const std::array<std::string_view, 1ZU> tokens{ token };
+                auto iter = tokens.cbegin();
+                return parse_option(index, values, iter, tokens.cend());
+            }
+
+            // トークンをオプションとして解釈した結果。
+            struct OptionMatch
+            {
+                // 値を処理すべきオプションのインデックス。
+                // 値を取らない短いオプションだけのまとまりは、すべて処理済みなので `std::nullopt` 。
+                std::optional<std::size_t> index;
+                // `-n5` や `--num=5` の `5` のように、同じトークン内に続く値。なければ次のトークンが値となる。
+                std::optional<std::string_view> attached;
+            };
+
+            // トークン `a` をこのコマンドのオプションとして解釈する。
+            //
+            // `--name` と `--name=value` はオプション名の基数木から、 `-abc` は短いオプション名の表から 1 文字ずつ引く。
+            // 短いオプションのまとまりは、値を取らないオプションをその場で `values` に格納しながら先頭から 1 度だけ走査し、
+            // 値を取るオプションに出会った時点でそのオプションと残りの文字列を返す。
+            // `a` がオプションでなければ `std::nullopt` を、オプションの処理に失敗した場合はそのエラーを返す。
+            constexpr std::expected<std::optional<OptionMatch>, col::ParseError> match_option(std::string_view a, ParsedArguments& values) const
+            {
+                if( a.starts_with("--") )
+                {
+                    // `--name=value` は最初の `=` で分け、値はトークンの後半をそのまま指す。
+                    // 名前はオプション名の一意な前置きに省略してもよく、複数のオプション名に一致する場合はエラーとなる。
+                    // `"--"` のみのトークンはどのオプション名にも一致しない。
+                    const auto name = a.substr(2ZU, a.find('=') - 2ZU);
+                    const auto [kind, found] = m_arg_trie.find(name);
+                    if( kind == NamePrefixMatchKind::NotFound )
+                    {
+                        return std::nullopt;
+                    }
+                    if( kind == NamePrefixMatchKind::Ambiguous )
+                    {
+                        return std::unexpected{
+                            col::ParseError{ col::ParseErrorKind::AmbiguousOption, a }
+                        };
+                    }
+                    if( name.size() + 2ZU == a.size() )
+                    {
+                        return OptionMatch{
+                            .index = found,
+                            .attached = std::nullopt,
+                        };
+                    }
+                    if( !takes_value[found] )
+                    {
+                        return std::unexpected{
+                            col::ParseError{ col::ParseErrorKind::UnexpectedOptionValue, a }.at_site(option_site(found))
+                        };
+                    }
+                    return OptionMatch{
+                        .index = found,
+                        .attached = a.substr(name.size() + 3ZU),
+                    };
+                }
+                if( a.size() < 2ZU || a[0] != '-' )
+                {
+                    return std::nullopt;
+                }
+                for( std::size_t i = 1ZU; i < a.size(); ++i )
+                {
+                    const auto index = m_short_index.find(a[i]);
+                    if( !index.has_value() )
+                    {
+                        return std::nullopt;
+                    }
+                    if( takes_value[*index] )
+                    {
+                        return OptionMatch{
+                            .index = index,
+                            .attached = i + 1ZU < a.size() ? std::optional{ a.substr(i + 1ZU) } : std::nullopt,
+                        };
+                    }
+                    const std::array<std::string_view, 0ZU> tokens{};
+                    auto iter = tokens.cbegin();
+                    if( auto res = parse_option(*index, values, iter, tokens.cend()); res.has_value() )
+                    {
+                        return std::unexpected{
+                            std::move(*res)
+                        };
+                    }
+                }
+                return OptionMatch{
+                    .index = std::nullopt,
+                    .attached = std::nullopt,
+                };
+            }
+
+            // 指定されなかった `index` 番目のオプション `config` の値 `value` をデフォルト値で埋める。
+            // 既に値を持つ場合は何もしない。失敗した場合はそのエラーを返す。
+            template <class ValueT, class De, class Pr>
+            static constexpr std::optional<col::ParseError> init_default(std::size_t index, const Arg<ValueT, De, Pr>& config, std::optional<ValueT>& value)
+            {
+                if( value.has_value() )
+                {
+                    return std::nullopt;
+                }
+                if constexpr( std::same_as<De, blank> )
+                {
+                    if constexpr( std::is_default_constructible_v<std::remove_cvref_t<ValueT>> )
+                    {
+                        value.emplace();
+                        return std::nullopt;
+                    }
+                    else
+                    {
+                        return col::ParseError{ col::ParseErrorKind::InvalidConfiguration, {}, static_cast<std::uint8_t>(col::InvalidConfigKind::EmptyDefault) }
+                            .at_site(option_site(index));
+                    }
+                }
+                else
+                {
+                    if constexpr( std::invocable<De> )
+                    {
+                        const auto invk_res = std::invoke(config.get_default());
+                        using R = std::remove_cvref_t<decltype(invk_res)>;
+                        if constexpr( std::convertible_to<R, ValueT> )
+                        {
+                            value.emplace(std::move(invk_res));
+                            return std::nullopt;
+                        }
+                        else if constexpr( col::is_std_optional_v<R> )
+                        {
+                            if( invk_res.has_value() )
+                            {
+                                value.emplace(std::move(*invk_res));
+                                return std::nullopt;
+                            }
+                            else
+                            {
+                                return col::ParseError{ col::ParseErrorKind::DefaultValueError }.at_site(option_site(index));
+                            }
+                        }
+                        else if constexpr( col::is_std_expected_v<R> )
+                        {
+                            if( invk_res.has_value() )
+                            {
+                                value.emplace(std::move(*invk_res));
+                                return std::nullopt;
+                            }
+                            else
+                            {
+                                if constexpr( std::convertible_to<typename R::error_type, col::ParseError> )
+                                {
+                                    return col::ParseError{ std::move(invk_res).error() }.at_site(option_site(index));
+                                }
+                                else
+                                {
+                                    return col::ParseError{ col::ParseErrorKind::DefaultValueError }.at_site(option_site(index));
+                                }
+                            }
+                        }
+                        else
+                        {
+                            return col::ParseError{ col::ParseErrorKind::InternalLogicError, {}, static_cast<std::uint8_t>(col::InternalLogicErrorKind::InvalidFunctionReturnType) }
+                                .at_site(option_site(index));
+                        }
+                    }
+                    else
+                    {
+                        value.emplace(config.get_default());
+                        return std::nullopt;
+                    }
+                }
+            }
+
+            // 引数をすべて読み終えた後、指定されなかったオプションをデフォルト値で埋め、 `Target` を生成する。
+            template <class Target>
+            constexpr std::expected<Target, col::ParseError> finish_impl(std::optional<SubCmdVariantType>& subcommand, ParsedArguments& parsed_arguments) const
+            {
                 auto zipped = col::zip_tuples(m_args, parsed_arguments);
 
-                while( iter != sentinel )
+                if( !subcommand.has_value() )
+                {
+                    subcommand.emplace(std::in_place_index<0>, std::monostate{});
+                }
+
+                std::size_t index = 0ZU;
+                const auto default_init_res = col::tuple_try_foreach(
+                    [&]<class ValueT, class De, class Pr>(std::tuple<const Arg<ValueT, De, Pr>&, std::optional<ValueT>&>& elem)
+                        -> col::ControlFlow<col::ParseError>
+                    {
+                        if( auto res = init_default(index, std::get<0>(elem), std::get<1>(elem)); res.has_value() )
+                        {
+                            return col::Break{ std::move(*res) };
+                        }
+                        ++index;
+                        return col::Continue{};
+                    },
+                    zipped);
+                if( default_init_res.is_break() )
+                {
+                    return std::unexpected{
+                        std::move(default_init_res).to_break()
+                    };
+                }
+
+                return std::apply([&]<class ...Ts>(Ts&& ...ts)
+                    {
+                        if constexpr( sizeof...(SubCmdTypes) > 0 )
+                        {
+                            return Target{ std::move(*subcommand), (*std::forward<Ts>(ts))... };
+                        }
+                        else
+                        {
+                            return Target{ (*std::forward<Ts>(ts))... };
+                        }
+                    }, std::move(parsed_arguments));
+            }
+
+            // コマンドライン引数を走査し終えてから、後回しにしたオプションの値を変換するまでの途中状態。
+            // `parse_async` と、並行に変換する `parse_parallel` が用いる。
+            struct DeferredState
+            {
+                // 走査しながらパースしたオプションの値。
+                ParsedArguments values;
+                // 変換を後回しにしたオプションの値のトークン。
+                std::array<std::optional<std::string_view>, sizeof...(ArgTypes)> tokens;
+                // サブコマンドの途中状態。
+                std::variant<std::monostate, typename SubCmdTypes::DeferredState...> sub;
+            };
+
+            // `parse_impl` と同じ解釈でコマンドライン引数を走査する。
+            // ただし `kind` で指定したオプションはその場でパースせず、値のトークンを `state` に記録する。
+            template <class I, class S>
+            requires (std::sentinel_for<S, I>)
+            constexpr std::optional<col::ParseError> scan_deferred(DeferredState& state, DeferKind kind, I& iter, const S& sentinel) const
+            {
+                while( iter != sentinel )
+                {
+                    const std::string_view a{ *iter };
+
+                    if( a == "--help" )
+                    {
+                        return col::ParseError{ col::ParseErrorKind::ShowHelp, a };
+                    }
+
+                    if constexpr( sizeof...(SubCmdTypes) > 0 )
+                    {
+                        if( const auto sub_index = m_sub_index.find(a); sub_index.has_value() )
+                        {
+                            std::ranges::advance(iter, 1);
+                            std::optional<col::ParseError> res{};
+                            [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+                            {
+                                static_cast<void>((
+                                    (Idx == *sub_index && (static_cast<void>(res = std::get<Idx>(m_subs).scan_deferred(state.sub.template emplace<Idx + 1ZU>(), kind, iter, sentinel)), true)) || ...
+                                ));
+                            }(std::index_sequence_for<SubCmdTypes...>{});
+                            if( res.has_value() )
+                            {
+                                return from_sub_error(*sub_index, std::move(*res));
+                            }
+                            // `parse_impl` と同じく、サブサブコマンドの後に残った引数はエラーとする
+                            break;
+                        }
+                    }
+
+                    if constexpr( sizeof...(ArgTypes) > 0 )
+                    {
+                        auto matched = match_option(a, state.values);
+                        if( !matched.has_value() )
+                        {
+                            return std::move(matched).error();
+                        }
+                        if( matched->has_value() )
+                        {
+                            std::ranges::advance(iter, 1);
+                            const auto& [index, attached] = **matched;
+                            if( !index.has_value() )
+                            {
+                                continue;
+                            }
+                            if( kind == DeferKind::AsyncParser ? is_async_arg[*index] : takes_value[*index] )
+                            {
+                                if( state.tokens[*index].has_value() )
+                                {
+                                    return col::ParseError{ col::ParseErrorKind::DuplicateOption }.at_site(option_site(*index));
+                                }
+                                if( attached.has_value() )
+                                {
+                                    state.tokens[*index].emplace(*attached);
+                                    continue;
+                                }
+                                if( iter == sentinel )
+                                {
+                                    return col::ParseError{ col::ParseErrorKind::MissingOptionValue }.at_site(option_site(*index));
+                                }
+                                state.tokens[*index].emplace(*iter);
+                                std::ranges::advance(iter, 1);
+                            }
+                            else if( auto res = attached.has_value()
+                                ? parse_option_from(*index, *attached, state.values)
+                                : parse_option(*index, state.values, iter, sentinel); res.has_value() )
+                            {
+                                return res;
+                            }
+                            continue;
+                        }
+                    }
+
+                    // どのサブサブコマンドでもオプションでもない
+                    return col::ParseError{ col::ParseErrorKind::UnknownOption, a };
+                }
+
+                if( iter != sentinel )
+                {
+                    return col::ParseError{ col::ParseErrorKind::UnknownOption, *iter };
+                }
+                return std::nullopt;
+            }
+
+            // `state` に記録したトークンを非同期のパーサーですべて同時にパースし、それらの完了を待ってから `Target` を生成するタスクを生成する。
+            // 複数のパースが失敗した場合は、親のコマンドから順に、各コマンドのオプションの定義順で最初のエラーを結果とする。
+            template <class Target>
+            col::Task<std::expected<Target, col::ParseError>> finish_async(DeferredState state) const
+            {
+                std::optional<SubCmdVariantType> subcommand{};
+                std::vector<col::Task<std::optional<col::ParseError>>> tasks{};
+                [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+                {
+                    const auto start = [&]<std::size_t Index>(std::integral_constant<std::size_t, Index>)
+                    {
+                        if constexpr( is_async_arg[Index] )
+                        {
+                            if( state.tokens[Index].has_value() )
+                            {
+                                tasks.push_back(std::get<Index>(m_args).parse_async(*state.tokens[Index], std::get<Index>(state.values), option_site(Index)));
+                            }
+                        }
+                    };
+                    (static_cast<void>(start(std::integral_constant<std::size_t, Idx>{})), ...);
+                }(std::index_sequence_for<ArgTypes...>{});
+                // `parse_parallel` と同じく、親のコマンドのオプションのエラーをサブコマンドのエラーより優先する
+                if constexpr( sizeof...(SubCmdTypes) > 0 )
+                {
+                    [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+                    {
+                        static_cast<void>((
+                            (state.sub.index() == Idx + 1ZU && (static_cast<void>(tasks.push_back(finish_sub_async<Idx>(std::move(std::get<Idx + 1ZU>(state.sub)), subcommand))), true)) || ...
+                        ));
+                    }(std::index_sequence_for<SubCmdTypes...>{});
+                }
+
+                for( auto& res : co_await col::when_all(std::move(tasks)) )
+                {
+                    if( res.has_value() )
+                    {
+                        co_return std::unexpected{
+                            std::move(*res)
+                        };
+                    }
+                }
+                co_return finish_impl<Target>(subcommand, state.values);
+            }
+
+            // `Idx` 番目のサブコマンドの `finish_async` の完了を待ち、そのパース結果を `subcommand` に格納するタスクを生成する。
+            // 失敗した場合はそのエラーを結果とする。
+            template <std::size_t Idx>
+            col::Task<std::optional<col::ParseError>> finish_sub_async(
+                typename std::tuple_element_t<Idx, std::tuple<SubCmdTypes...>>::DeferredState state,
+                std::optional<SubCmdVariantType>& subcommand) const
+            {
+                using SubCmdT = std::tuple_element_t<Idx, std::tuple<SubCmdTypes...>>;
+                auto res = co_await std::get<Idx>(m_subs).template finish_async<typename SubCmdT::value_type>(std::move(state));
+                if( !res.has_value() )
+                {
+                    co_return from_sub_error(Idx, std::move(res).error());
+                }
+                subcommand.emplace(std::in_place_index<Idx + 1ZU>, std::move(*res));
+                co_return std::nullopt;
+            }
+
+            // 後回しにした `Index` 番目のオプションの値を変換する。指定されなかった場合はデフォルト値で埋める。
+            // `cmd` はこのコマンド、 `state` はこのコマンドの途中状態を指す。
+            template <std::size_t Index>
+            static std::optional<col::ParseError> run_deferred_job(const void* cmd, void* state)
+            {
+                const auto& self = *static_cast<const CmdBase*>(cmd);
+                auto& deferred = *static_cast<DeferredState*>(state);
+                if( const auto& token = deferred.tokens[Index]; token.has_value() )
+                {
+                    return self.parse_option_from(Index, *token, deferred.values);
+                }
+                return init_default(Index, std::get<Index>(self.m_args), std::get<Index>(deferred.values));
+            }
+
+            // このコマンドと、 `state` が指すサブコマンドの各オプションについて、後回しにした処理を `jobs` に追加する。
+            // 親のコマンドから順に、各コマンドのオプションの定義順に追加する。
+            // `site` は、ルートのコマンドから見たこのコマンドのエラーの位置。
+            void collect_deferred_jobs(DeferredState& state, std::vector<DeferredJob>& jobs, std::size_t site) const
+            {
+                [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+                {
+                    (static_cast<void>(jobs.push_back(DeferredJob{
+                        .run = &run_deferred_job<Idx>,
+                        .cmd = this,
+                        .state = &state,
+                        .site = site,
+                    })), ...);
+                }(std::index_sequence_for<ArgTypes...>{});
+                if constexpr( sizeof...(SubCmdTypes) > 0 )
+                {
+                    [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+                    {
+                        static_cast<void>((
+                            (state.sub.index() == Idx + 1ZU && (static_cast<void>(std::get<Idx>(m_subs).collect_deferred_jobs(std::get<Idx + 1ZU>(state.sub), jobs, site + sub_error_sites[Idx])), true)) || ...
+                        ));
+                    }(std::index_sequence_for<SubCmdTypes...>{});
+                }
+            }
+
+            // 後回しにした処理をすべて終えた `state` から `Target` を生成する。
+            template <class Target>
+            constexpr std::expected<Target, col::ParseError> finish_deferred(DeferredState& state) const
+            {
+                std::optional<SubCmdVariantType> subcommand{};
+                if constexpr( sizeof...(SubCmdTypes) > 0 )
+                {
+                    std::optional<col::ParseError> error{};
+                    [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+                    {
+                        const auto finish_sub = [&]<std::size_t Index>(std::integral_constant<std::size_t, Index>)
+                        {
+                            using SubCmdT = std::tuple_element_t<Index, std::tuple<SubCmdTypes...>>;
+                            auto res = std::get<Index>(m_subs).template finish_deferred<typename SubCmdT::value_type>(std::get<Index + 1ZU>(state.sub));
+                            if( res.has_value() )
+                            {
+                                subcommand.emplace(std::in_place_index<Index + 1ZU>, std::move(*res));
+                            }
+                            else
+                            {
+                                error.emplace(from_sub_error(Index, std::move(res).error()));
+                            }
+                        };
+                        static_cast<void>((
+                            (state.sub.index() == Idx + 1ZU && (static_cast<void>(finish_sub(std::integral_constant<std::size_t, Idx>{})), true)) || ...
+                        ));
+                    }(std::index_sequence_for<SubCmdTypes...>{});
+                    if( error.has_value() )
+                    {
+                        return std::unexpected{
+                            std::move(*error)
+                        };
+                    }
+                }
+                return finish_impl<Target>(subcommand, state.values);
+            }
+
+            // コマンドライン引数を走査し終えてから、値を取るオプションの変換とデフォルト値の生成を
+            // `m_parallelism` 個までのスレッドで並行に行い、 `Target` を生成する。
+            //
+            // 変換が複数失敗した場合は、親のコマンドから順に、各コマンドのオプションの定義順で最初のエラーを返す。
+            // エラーはスレッドの実行順によらず決まる。
+            //
+            // 走査中のエラーは変換より先に返り、変換のエラーはトークンの順ではなく定義順で選ばれるため、
+            // 同じコマンドライン引数でも `parse_impl` と異なるエラーを返すことがある。
+            // たとえば `--first ng --first ok` は、 `parse_impl` では `ng` の `ValueParserError` になり、ここでは `DuplicateOption` になる。
+            template <class Target, class I, class S>
+            requires (std::sentinel_for<S, I>)
+            std::expected<Target, col::ParseError> parse_parallel(I& iter, const S& sentinel) const
+            {
+                DeferredState state{};
+                if( auto res = scan_deferred(state, DeferKind::Value, iter, sentinel); res.has_value() )
                 {
-                    const std::string_view a{ *iter };
+                    return std::unexpected{
+                        std::move(*res)
+                    };
+                }
 
-                    // TODO: `--help` の自動定義を選択可能にする
-                    if( a == "--help" )
+                std::vector<DeferredJob> jobs{};
+                collect_deferred_jobs(state, jobs, 0ZU);
+                for( auto& res : detail::run_deferred_jobs(jobs, m_parallelism) )
+                {
+                    if( res.has_value() )
                     {
                         return std::unexpected{
-                            col::ShowHelp{
-                                .help_message = get_usage_impl(parent_cmd, DefaultIndentWidthForUsage),
-                            }
+                            std::move(*res)
                         };
                     }
+                }
+                return finish_deferred<Target>(state);
+            }
 
+        public:
+            // `parse_impl` と同じ解釈を 1 トークンずつ進めるための途中状態。 `col::ParseSession` が用いる。
+            //
+            // 各オプションのパース結果と、パース中のサブコマンドの途中状態を保持する。
+            // 値を取るオプション名を受け取った直後は、そのオプションを値の待ち状態として保持する。
+            template <class Target = T>
+            class SessionState
+            {
+                using SubStates = std::variant<std::monostate, typename SubCmdTypes::template SessionState<>...>;
+
+                const CmdBase* m_cmd;
+                ParsedArguments m_values;
+                SubStates m_sub;
+                // 値を待っているオプションのインデックス。
+                std::optional<std::size_t> m_pending;
+
+            public:
+                constexpr explicit SessionState(const CmdBase& cmd) noexcept
+                : m_cmd{ &cmd }
+                , m_values{}
+                , m_sub{}
+                , m_pending{}
+                {}
+
+                // トークン `a` を 1 つ処理する。失敗した場合はそのエラーを返す。
+                constexpr std::optional<col::ParseError> feed(std::string_view a)
+                {
                     if constexpr( sizeof...(SubCmdTypes) > 0 )
                     {
-                        if( !subcommand.has_value() )
+                        // サブコマンドに入った後の引数はすべてサブコマンドのもの
+                        if( m_sub.index() != 0ZU )
                         {
-                            const auto subsub_res = col::tuple_try_foreach(
-                                [&]<class SubCmdT>(const SubCmdT& sub)
-                                    -> col::ControlFlow<std::optional<col::ParseError>>
+                            auto res = std::visit([&]<class SubState>(SubState& sub) -> std::optional<col::ParseError>
                                 {
-                                    if( a != sub.get_name() )
-                                    {
-                                        return col::Continue{};
-                                    }
-                                    std::ranges::advance(iter, 1);
-                                    std::string parent{};
-                                    if( !parent_cmd.empty() )
-                                    {
-                                        parent += parent_cmd;
-                                        parent += ' ';
-                                    }
-                                    parent += get_name();
-                                    const auto res = sub.parse_impl(parent, iter, sentinel);
-                                    if( res.has_value() )
+                                    if constexpr( std::same_as<SubState, std::monostate> )
                                     {
-                                        subcommand.emplace(std::move(*res));
-                                        return col::Break{ std::nullopt };
+                                        return std::nullopt;
                                     }
                                     else
                                     {
-                                        return col::Break{
-                                            std::move(res).error()
-                                        };
+                                        return sub.feed(a);
                                     }
-                                },
-                                m_subs);
-                            if( subsub_res.is_break() )
+                                }, m_sub);
+                            if( res.has_value() )
                             {
-                                if( subsub_res.to_break().has_value() )
-                                {
-                                    return std::unexpected{
-                                        *std::move(subsub_res).to_break()
-                                    };
-                                }
-                                else
-                                {
-                                    // col::Break{std::nullopt} のとき、サブサブコマンドがパース成功したことを意味する。
-                                    // 残りの引数を続けてこのサブコマンドの引数として解釈できるが直感的ではないので、
-                                    // ここで break して残りの引数はエラーとする。
-                                    break;
-                                }
+                                return m_cmd->from_sub_error(m_sub.index() - 1ZU, std::move(*res));
                             }
+                            return std::nullopt;
                         }
                     }
 
-                    const auto res = col::tuple_try_foreach(
-                        [&]<class ValueT, class DefaultT, class ParserT>
-                            (std::tuple<const Arg<ValueT, DefaultT, ParserT>&, std::optional<ValueT>&>& elem)
-                            -> col::ControlFlow<std::optional<col::ParseError>>
-                        {
-                            const Arg<ValueT, DefaultT, ParserT>& arg = std::get<0>(elem);
-                            if( !a.starts_with("--") || a.size() <= 2 || a.substr(2) != arg.get_name() )
-                            {
-                                return col::Continue{};
-                            }
-                            std::optional<ValueT>& value = std::get<1>(elem);
-                            if( value.has_value() )
-                            {
-                                return col::Break{
-                                    col::DuplicateOption{
-                                        .name = arg.get_name(),
-                                    }
-                                };
-                            }
-                            std::ranges::advance(iter, 1);
-                            const auto parse_res = arg.parse(iter, sentinel);
-                            if( parse_res.has_value() )
-                            {
-                                value.emplace(std::move(*parse_res));
-                                return col::Break{ std::nullopt };
-                            }
-                            else
-                            {
-                                return col::Break{
-                                    std::move(std::move(parse_res).error())
-                                };
-                            }
-                        }, zipped);
-                    if( res.is_break() )
+                    if constexpr( sizeof...(ArgTypes) > 0 )
                     {
-                        const auto brk = std::move(res).to_break();
-                        if( brk.has_value() )
+                        if( m_pending.has_value() )
                         {
-                            return std::unexpected{
-                                std::move(*brk)
-                            };
-                        }
-                        else
-                        {
-                            continue;
+                            return m_cmd->parse_option_from(*std::exchange(m_pending, std::nullopt), a, m_values);
                         }
                     }
-                    else
+
+                    if( a == "--help" )
                     {
-                        // どのサブサブコマンドでもオプションでもない
-                        return std::unexpected{
-                            col::UnknownOption{
-                                .arg = *iter,
-                            }
-                        };
+                        return col::ParseError{ col::ParseErrorKind::ShowHelp, a };
                     }
-                }
 
-                if( iter != sentinel )
-                {
-                    return std::unexpected{
-                        col::UnknownOption{
-                            .arg = *iter,
+                    if constexpr( sizeof...(SubCmdTypes) > 0 )
+                    {
+                        if( const auto sub_index = m_cmd->m_sub_index.find(a); sub_index.has_value() )
+                        {
+                            [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+                            {
+                                static_cast<void>((
+                                    (Idx == *sub_index && (static_cast<void>(m_sub.template emplace<Idx + 1ZU>(std::get<Idx>(m_cmd->m_subs))), true)) || ...
+                                ));
+                            }(std::index_sequence_for<SubCmdTypes...>{});
+                            return std::nullopt;
                         }
-                    };
-                }
-
-                if( !subcommand.has_value() )
-                {
-                    subcommand.emplace(std::in_place_index<0>, std::monostate{});
-                }
+                    }
 
-                const auto default_init_res = col::tuple_try_foreach(
-                    [&]<class ValueT, class De, class Pr>(std::tuple<const Arg<ValueT, De, Pr>&, std::optional<ValueT>&>& elem)
-                        -> col::ControlFlow<col::ParseError>
+                    if constexpr( sizeof...(ArgTypes) > 0 )
                     {
-                        std::optional<ValueT>& value = std::get<1>(elem);
-                        if( value.has_value() )
+                        auto matched = m_cmd->match_option(a, m_values);
+                        if( !matched.has_value() )
                         {
-                            return col::Continue{};
+                            return std::move(matched).error();
                         }
-                        const Arg<ValueT, De, Pr>& config = std::get<0>(elem);
-                        if constexpr( std::same_as<De, blank> )
+                        if( matched->has_value() )
                         {
-                            if constexpr( std::is_default_constructible_v<std::remove_cvref_t<ValueT>> )
+                            const auto& [index, attached] = **matched;
+                            if( !index.has_value() )
                             {
-                                value.emplace();
-                                return col::Continue{};
+                                return std::nullopt;
                             }
-                            else
+                            if( attached.has_value() )
                             {
-                                return col::Break{
-                                    col::InvalidConfiguration{
-                                        .name = config.get_name(),
-                                        .kind = col::InvalidConfigKind::EmptyDefault,
-                                    }
-                                };
+                                return m_cmd->parse_option_from(*index, *attached, m_values);
+                            }
+                            const bool given = col::tuple_visit_at(*index, [](const auto& value) noexcept { return value.has_value(); }, m_values);
+                            if( given || !takes_value[*index] )
+                            {
+                                // 重複の検出、および値を取らないオプションは `parse_impl` と同じく即座に処理する
+                                const std::array<std::string_view, 0ZU> tokens{};
+                                auto iter = tokens.cbegin();
+                                return m_cmd->parse_option(*index, m_values, iter, tokens.cend());
                             }
+                            m_pending = *index;
+                            return std::nullopt;
                         }
-                        else
+                    }
+
+                    // どのサブサブコマンドでもオプションでもない
+                    return col::ParseError{ col::ParseErrorKind::UnknownOption, a };
+                }
+
+                // すべてのトークンを処理し終えたものとして、パース結果を生成する。
+                constexpr std::expected<Target, col::ParseError> finish()
+                {
+                    std::optional<SubCmdVariantType> subcommand{};
+                    if constexpr( sizeof...(SubCmdTypes) > 0 )
+                    {
+                        if( m_sub.index() != 0ZU )
                         {
-                            if constexpr( std::invocable<De> )
-                            {
-                                const auto invk_res = std::invoke(config.get_default());
-                                using R = std::remove_cvref_t<decltype(invk_res)>;
-                                if constexpr( std::convertible_to<R, ValueT> )
-                                {
-                                    value.emplace(std::move(invk_res));
-                                    return col::Continue{};
-                                }
-                                else if constexpr( col::is_std_optional_v<R> )
+                            auto sub_res = std::visit([&]<class SubState>(SubState& sub) -> std::expected<SubCmdVariantType, col::ParseError>
                                 {
-                                    if( invk_res.has_value() )
+                                    if constexpr( std::same_as<SubState, std::monostate> )
                                     {
-                                        value.emplace(std::move(*invk_res));
-                                        return col::Continue{};
+                                        return SubCmdVariantType{ std::in_place_index<0>, std::monostate{} };
                                     }
                                     else
                                     {
-                                        return col::Break{
-                                            col::DefaultValueError {
-                                                .name = config.get_name(),
-                                            }
-                                        };
-                                    }
-                                }
-                                else if constexpr( col::is_std_expected_v<R> )
-                                {
-                                    if( invk_res.has_value() )
-                                    {
-                                        value.emplace(std::move(*invk_res));
-                                        return col::Continue{};
-                                    }
-                                    else
-                                    {
-                                        if constexpr( std::convertible_to<typename R::error_type, col::ParseError> )
+                                        auto res = sub.finish();
+                                        if( res.has_value() )
                                         {
-                                            return col::Break{
-                                                std::unexpected{
-                                                    std::move(invk_res).error()
-                                                }
-                                            };
+                                            return SubCmdVariantType{ std::move(*res) };
                                         }
                                         else
                                         {
-                                            return col::Break{
-                                                col::DefaultValueError {
-                                                    .name = config.get_name(),
-                                                }
+                                            return std::unexpected{
+                                                m_cmd->from_sub_error(m_sub.index() - 1ZU, std::move(res).error())
                                             };
                                         }
                                     }
-                                }
-                                else
-                                {
-                                    return col::Break{
-                                        col::InternalLogicError{
-                                            .name = config.get_name(),
-                                            .kind = col::InternalLogicErrorKind::InvalidFunctionReturnType,
-                                        }
-                                    };
-                                }
-                            }
-                            else
+                                }, m_sub);
+                            if( !sub_res.has_value() )
                             {
-                                value.emplace(config.get_default());
-                                return col::Continue{};
+                                return std::unexpected{
+                                    std::move(sub_res).error()
+                                };
                             }
+                            subcommand.emplace(std::move(*sub_res));
                         }
-                    },
-                    zipped);
-                if( default_init_res.is_break() )
-                {
-                    return std::unexpected{
-                        std::move(default_init_res).to_break()
-                    };
-                }
+                    }
 
-                return std::apply([&]<class ...Ts>(Ts&& ...ts)
+                    if constexpr( sizeof...(ArgTypes) > 0 )
                     {
-                        if constexpr( sizeof...(SubCmdTypes) > 0 )
-                        {
-                            return Target{ std::move(*subcommand), (*std::forward<Ts>(ts))... };
-                        }
-                        else
+                        if( m_pending.has_value() )
                         {
-                            return Target{ (*std::forward<Ts>(ts))... };
+                            // 値を待っているオプションに値を与えずに終えた
+                            const std::array<std::string_view, 0ZU> tokens{};
+                            auto iter = tokens.cbegin();
+                            if( auto res = m_cmd->parse_option(*m_pending, m_values, iter, tokens.cend()); res.has_value() )
+                            {
+                                return std::unexpected{
+                                    std::move(*res)
+                                };
+                            }
                         }
-                    }, std::move(parsed_arguments));
-            }
+                    }
+
+                    return m_cmd->template finish_impl<Target>(subcommand, m_values);
+                }
+            };
         };
 
     } // namespace detail
 
+    // コマンドライン引数を 1 トークンずつ与えてパースするための途中状態。 `col::Cmd::session<T>()` で生成する。
+    //
+    // 与えたトークンはその場で解釈され、オプションの値の途中結果とサブコマンドの位置だけを保持する。
+    // トークンを溜め込んだり、先頭からパースし直したりはしない。
+    // すべてのトークンを 1 度の `parse` で与えた場合と同じ結果になる。
+    //
+    // トークンは `parse` に渡すコマンドライン引数と同じく、終端文字で終わり、パース結果を使い終えるまで生存していなければならない。
+    // コマンド `CmdT` も、この値を使い終えるまで生存していなければならない。
+    template <class T, class CmdT>
+    class [[nodiscard]] ParseSession
+    {
+        typename CmdT::template SessionState<T> m_state;
+        std::optional<col::ParseError> m_error;
+    public:
+        constexpr explicit ParseSession(const CmdT& cmd) noexcept
+        : m_state{ cmd }
+        , m_error{}
+        {}
+
+        // トークンを 1 つ与える。
+        // 失敗した場合はそのエラーを返し、以降の `feed` および `finish` は同じエラーを返す。
+        constexpr std::expected<void, col::ParseError> feed(std::string_view token)
+        {
+            if( !m_error.has_value() )
+            {
+                m_error = m_state.feed(token);
+            }
+            if( m_error.has_value() )
+            {
+                return std::unexpected{ *m_error };
+            }
+            return {};
+        }
+
+        // トークンをすべて与え終えたものとして、パース結果を生成する。 1 度だけ呼び出せる。
+        [[nodiscard]] constexpr std::expected<T, col::ParseError> finish()
+        {
+            if( m_error.has_value() )
+            {
+                return std::unexpected{ *m_error };
+            }
+            return m_state.finish();
+        }
+    };
+
     // サブコマンドの型。
     //
     // 型 `M` は、このサブコマンドのパース結果に対応させる型。
@@ -1549,7 +3630,14 @@ namespace col {
         // `indent_width` で指定したインデント幅をもとに出力される。
         [[nodiscard]] constexpr std::string get_usage(std::size_t indent_width) const
         {
-            return this->get_usage_impl("", indent_width);
+            return this->get_usage_impl(CommandPath{}, indent_width);
+        }
+
+        // このコマンドのパースが返したエラー `err` の詳細を、このコマンドの定義から復元する。
+        // `err` の原因となったトークンが指す文字列は、生存していなければならない。
+        [[nodiscard]] constexpr col::ParseErrorDetail explain(const col::ParseError& err) const noexcept
+        {
+            return this->explain_impl(err, err.site());
         }
 
         // このコマンドにコマンドライン引数を追加する。
@@ -1591,6 +3679,21 @@ namespace col {
             return std::move(*this).template add_impl<Self>(std::move(sub));
         }
 
+        // オプションの値の変換とデフォルト値の生成を、コマンドライン引数の走査を終えてから最大 `threads` 個のスレッドで並行に行うようにする。
+        // `threads` が 1 以下であれば、走査しながら 1 つずつ変換する。既定値は 0 。
+        // コンパイル時のパースと `session` 、 `parse_async` では常に 1 つずつ変換する。
+        //
+        // パーサーとデフォルト値を得る呼び出し可能オブジェクトは、別のスレッドから同時に呼び出せるものでなければならない。
+        //
+        // 並行に変換する場合、コマンドライン引数が複数の誤りを含むと、 1 つずつ変換するときと異なるエラーを返すことがある。
+        // 重複や未知のオプションなど走査中に見つかるエラーは変換のエラーより優先され、
+        // 変換のエラーはトークンの順ではなく、親のコマンドから順に各コマンドのオプションの定義順で選ばれる。
+        constexpr Self set_parallelism(std::size_t threads) &&
+            noexcept (std::is_nothrow_move_constructible_v<Self>)
+        {
+            return std::move(*this).template set_parallelism_impl<Self>(threads);
+        }
+
         // コマンドライン引数の範囲 `R` をパースして、指定した型 `T` を生成する。
         template <class T, class R>
         requires (
@@ -1618,7 +3721,72 @@ namespace col {
         )
         [[nodiscard]] constexpr std::expected<T, col::ParseError> parse(I& iter, const S& sentinel) const
         {
-            return this->template parse_impl<T>("", iter, sentinel);
+            static_assert(Self::depth <= MaxCommandDepth, "too deeply nested subcommands");
+            if !consteval
+            {
+                if( this->get_parallelism() > 1ZU )
+                {
+                    return this->template parse_parallel<T>(iter, sentinel);
+                }
+            }
+            return this->template parse_impl<T>(iter, sentinel);
+        }
+
+        // コマンドライン引数を 1 トークンずつ与えてパースする `col::ParseSession` を生成し、指定した型 `T` をパースする。
+        template <class T>
+        requires (
+            !std::same_as<std::remove_cvref_t<T>, blank> &&
+            std::is_constructible_v<T, typename ArgTypes::value_type...>
+        )
+        [[nodiscard]] constexpr ParseSession<T, Self> session() const noexcept
+        {
+            static_assert(Self::depth <= MaxCommandDepth, "too deeply nested subcommands");
+            return ParseSession<T, Self>{ *this };
+        }
+
+        // コマンドライン引数の範囲 `R` を非同期にパースして、指定した型 `T` を生成するタスクを生成する。
+        //
+        // 変換を後回しにしたトークンは `R` の要素を参照したままタスクに渡るため、 `R` は借用された範囲でなければならない。
+        // `std::vector<std::string>` などの要素を所有する範囲は左辺値として渡す。
+        // `R` の要素が指す文字列は、タスクが完了するまで生存していなければならない。
+        template <class T, class R>
+        requires (
+            !std::same_as<std::remove_cvref_t<T>, blank> &&
+            std::ranges::borrowed_range<R> &&
+            std::ranges::viewable_range<R> &&
+            std::convertible_to<col::range_const_reference_t<R>, std::string_view> &&
+            std::is_constructible_v<T, typename ArgTypes::value_type...>
+        )
+        [[nodiscard]] col::Task<std::expected<T, col::ParseError>> parse_async(R&& r) const
+        {
+            const auto view = std::ranges::views::all(std::forward<R>(r));
+            auto iter = std::ranges::cbegin(view);
+            const auto sentinel = std::ranges::cend(view);
+            return parse_async<T>(iter, sentinel);
+        }
+
+        // コマンドライン引数を指しているイテレータ `I` およびその番兵 `S` を入力として、指定した型 `T` を非同期にパースするタスクを生成する。
+        // コマンドライン引数の走査はこの呼び出しの中で終え、イテレータは適切な数だけ進行する。
+        // `col::Task` を返すパーサーを持つオプションは、タスクの中ですべて同時に開始し、それらの完了を待ってから `T` を生成する。
+        // 複数のパーサーが失敗した場合は、並行に変換する `parse` と同じく、親のコマンドから順に、各コマンドのオプションの定義順で最初のエラーを結果とする。
+        //
+        // このコマンドと、コマンドライン引数が指す文字列は、タスクが完了するまで生存していなければならない。
+        template <class T, class I, class S>
+        requires (
+            !std::same_as<std::remove_cvref_t<T>, blank> &&
+            std::sentinel_for<S, I> &&
+            std::convertible_to<col::iter_const_reference_t<I>, std::string_view> &&
+            std::is_constructible_v<T, typename ArgTypes::value_type...>
+        )
+        [[nodiscard]] col::Task<std::expected<T, col::ParseError>> parse_async(I& iter, const S& sentinel) const
+        {
+            static_assert(Self::depth <= MaxCommandDepth, "too deeply nested subcommands");
+            typename Self::DeferredState state{};
+            if( auto res = this->scan_deferred(state, detail::DeferKind::AsyncParser, iter, sentinel); res.has_value() )
+            {
+                return col::ready_task(std::expected<T, col::ParseError>{ std::unexpect, std::move(*res) });
+            }
+            return this->template finish_async<T>(std::move(state));
         }
     };
 
@@ -1647,7 +3815,14 @@ namespace col {
         // `indent_width` で指定したインデント幅をもとに出力される。
         [[nodiscard]] constexpr std::string get_usage(std::size_t indent_width) const
         {
-            return this->get_usage_impl("", indent_width);
+            return this->get_usage_impl(CommandPath{}, indent_width);
+        }
+
+        // このコマンドのパースが返したエラー `err` の詳細を、このコマンドの定義から復元する。
+        // `err` の原因となったトークンが指す文字列は、生存していなければならない。
+        [[nodiscard]] constexpr col::ParseErrorDetail explain(const col::ParseError& err) const noexcept
+        {
+            return this->explain_impl(err, err.site());
         }
 
         // このコマンドにコマンドライン引数を追加する。
@@ -1689,6 +3864,21 @@ namespace col {
             return std::move(*this).template add_impl<Self>(std::move(sub));
         }
 
+        // オプションの値の変換とデフォルト値の生成を、コマンドライン引数の走査を終えてから最大 `threads` 個のスレッドで並行に行うようにする。
+        // `threads` が 1 以下であれば、走査しながら 1 つずつ変換する。既定値は 0 。
+        // コンパイル時のパースと `session` 、 `parse_async` では常に 1 つずつ変換する。
+        //
+        // パーサーとデフォルト値を得る呼び出し可能オブジェクトは、別のスレッドから同時に呼び出せるものでなければならない。
+        //
+        // 並行に変換する場合、コマンドライン引数が複数の誤りを含むと、 1 つずつ変換するときと異なるエラーを返すことがある。
+        // 重複や未知のオプションなど走査中に見つかるエラーは変換のエラーより優先され、
+        // 変換のエラーはトークンの順ではなく、親のコマンドから順に各コマンドのオプションの定義順で選ばれる。
+        constexpr Self set_parallelism(std::size_t threads) &&
+            noexcept (std::is_nothrow_move_constructible_v<Self>)
+        {
+            return std::move(*this).template set_parallelism_impl<Self>(threads);
+        }
+
         // コマンドライン引数の範囲 `R` をパースして、指定した型 `T` を生成する。
         template <class T, class R>
         requires (
@@ -1716,7 +3906,72 @@ namespace col {
         )
         [[nodiscard]] constexpr std::expected<T, col::ParseError> parse(I& iter, const S& sentinel) const
         {
-            return this->template parse_impl<T>("", iter, sentinel);
+            static_assert(Self::depth <= MaxCommandDepth, "too deeply nested subcommands");
+            if !consteval
+            {
+                if( this->get_parallelism() > 1ZU )
+                {
+                    return this->template parse_parallel<T>(iter, sentinel);
+                }
+            }
+            return this->template parse_impl<T>(iter, sentinel);
+        }
+
+        // コマンドライン引数を 1 トークンずつ与えてパースする `col::ParseSession` を生成し、指定した型 `T` をパースする。
+        template <class T>
+        requires (
+            !std::same_as<std::remove_cvref_t<T>, blank> &&
+            std::is_constructible_v<T, std::variant<std::monostate, typename SubCmdTypes::value_type...>, typename ArgTypes::value_type...>
+        )
+        [[nodiscard]] constexpr ParseSession<T, Self> session() const noexcept
+        {
+            static_assert(Self::depth <= MaxCommandDepth, "too deeply nested subcommands");
+            return ParseSession<T, Self>{ *this };
+        }
+
+        // コマンドライン引数の範囲 `R` を非同期にパースして、指定した型 `T` を生成するタスクを生成する。
+        //
+        // 変換を後回しにしたトークンは `R` の要素を参照したままタスクに渡るため、 `R` は借用された範囲でなければならない。
+        // `std::vector<std::string>` などの要素を所有する範囲は左辺値として渡す。
+        // `R` の要素が指す文字列は、タスクが完了するまで生存していなければならない。
+        template <class T, class R>
+        requires (
+            !std::same_as<std::remove_cvref_t<T>, blank> &&
+            std::ranges::borrowed_range<R> &&
+            std::ranges::viewable_range<R> &&
+            std::convertible_to<col::range_const_reference_t<R>, std::string_view> &&
+            std::is_constructible_v<T, std::variant<std::monostate, typename SubCmdTypes::value_type...>, typename ArgTypes::value_type...>
+        )
+        [[nodiscard]] col::Task<std::expected<T, col::ParseError>> parse_async(R&& r) const
+        {
+            const auto view = std::ranges::views::all(std::forward<R>(r));
+            auto iter = std::ranges::cbegin(view);
+            const auto sentinel = std::ranges::cend(view);
+            return parse_async<T>(iter, sentinel);
+        }
+
+        // コマンドライン引数を指しているイテレータ `I` およびその番兵 `S` を入力として、指定した型 `T` を非同期にパースするタスクを生成する。
+        // コマンドライン引数の走査はこの呼び出しの中で終え、イテレータは適切な数だけ進行する。
+        // `col::Task` を返すパーサーを持つオプションは、タスクの中ですべて同時に開始し、それらの完了を待ってから `T` を生成する。
+        // 複数のパーサーが失敗した場合は、並行に変換する `parse` と同じく、親のコマンドから順に、各コマンドのオプションの定義順で最初のエラーを結果とする。
+        //
+        // このコマンドと、コマンドライン引数が指す文字列は、タスクが完了するまで生存していなければならない。
+        template <class T, class I, class S>
+        requires (
+            !std::same_as<std::remove_cvref_t<T>, blank> &&
+            std::sentinel_for<S, I> &&
+            std::convertible_to<col::iter_const_reference_t<I>, std::string_view> &&
+            std::is_constructible_v<T, std::variant<std::monostate, typename SubCmdTypes::value_type...>, typename ArgTypes::value_type...>
+        )
+        [[nodiscard]] col::Task<std::expected<T, col::ParseError>> parse_async(I& iter, const S& sentinel) const
+        {
+            static_assert(Self::depth <= MaxCommandDepth, "too deeply nested subcommands");
+            typename Self::DeferredState state{};
+            if( auto res = this->scan_deferred(state, detail::DeferKind::AsyncParser, iter, sentinel); res.has_value() )
+            {
+                return col::ready_task(std::expected<T, col::ParseError>{ std::unexpect, std::move(*res) });
+            }
+            return this->template finish_async<T>(std::move(state));
         }
     };
 
@@ -1725,6 +3980,32 @@ namespace col {
     requires (std::convertible_to<T, std::string_view> && std::convertible_to<U, std::string_view>)
     Cmd(T, U) -> Cmd<>;
 
+    namespace detail {
+
+        // 静的記憶域に置かれたコマンド `C` の usage 文字列。末尾に `'\0'` を含む。
+        template <const auto& C, std::size_t IndentWidth>
+        inline constexpr auto static_usage_buffer = []
+            {
+                constexpr std::size_t size = C.get_usage(IndentWidth).size();
+                std::array<char, size + 1ZU> buffer{};
+                std::ranges::copy(C.get_usage(IndentWidth), buffer.begin());
+                return buffer;
+            }();
+
+    } // namespace detail
+
+    // 定数式で構築されたコマンド `C` の usage 文字列を、コンパイル時に生成して静的記憶域から得る。
+    // 実行時には usage 文字列の構築もアロケーションも行わない。
+    //
+    // `C` は静的記憶域期間を持つ `constexpr` なコマンドでなければならない。
+    // 得られる文字列の直後には `'\0'` が置かれている。
+    template <const auto& C, std::size_t IndentWidth = DefaultIndentWidthForUsage>
+    requires requires { { C.get_usage(IndentWidth) } -> std::same_as<std::string>; }
+    [[nodiscard]] constexpr std::string_view static_usage() noexcept
+    {
+        const auto& buffer = detail::static_usage_buffer<C, IndentWidth>;
+        return std::string_view{ buffer.data(), buffer.size() - 1ZU };
+    }
 
 } // namespace col
 
@@ -1,18 +1,281 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
 #include <charconv>
 #include <concepts>
 #include <expected>
+#include <iterator>
+#include <limits>
 #include <string_view>
 #include <system_error>
+#include <type_traits>
 #include <utility>
 
+#if defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
 namespace col {
+
+    namespace detail {
+
+        // バイトごとの最上位ビット。
+        inline constexpr std::uint64_t swar_high_bits = 0x8080808080808080ULL;
+
+        // すべてのバイトが `byte` である 64 ビット値。
+        constexpr std::uint64_t swar_broadcast(std::uint8_t byte) noexcept
+        {
+            return 0x0101010101010101ULL * byte;
+        }
+
+        // `p` から 8 バイトを、先頭の文字が最下位バイトになるように読み込む。
+        inline std::uint64_t swar_load8(const char* p) noexcept
+        {
+            std::uint64_t v{};
+            std::memcpy(&v, p, sizeof(v));
+            if constexpr( std::endian::native == std::endian::big )
+            {
+                v = std::byteswap(v);
+            }
+            return v;
+        }
+
+        // 最上位ビットが立っていない各バイト `x` について、 `lo <= x <= hi` のバイトだけ最上位ビットを立てて返す。
+        constexpr std::uint64_t swar_in_range(std::uint64_t v, std::uint8_t lo, std::uint8_t hi) noexcept
+        {
+            const auto ge_lo = v + swar_broadcast(static_cast<std::uint8_t>(0x80U - lo));
+            const auto gt_hi = v + swar_broadcast(static_cast<std::uint8_t>(0x7FU - hi));
+            return ge_lo & ~gt_hi & swar_high_bits;
+        }
+
+        // `p` から始まる 8 文字の 10 進数を変換する。数字以外を含む場合は `false` を返す。
+        inline bool parse_decimal8(const char* p, std::uint64_t& out) noexcept
+        {
+            auto v = swar_load8(p);
+            if( (v & swar_high_bits) != 0U || swar_in_range(v, '0', '9') != swar_high_bits )
+            {
+                return false;
+            }
+            v -= swar_broadcast('0');
+            v = (v * 10U) + (v >> 8U);
+            v = (((v & 0x000000FF000000FFULL) * (100U + (1000000ULL << 32U))) +
+                (((v >> 16U) & 0x000000FF000000FFULL) * (1U + (10000ULL << 32U)))) >> 32U;
+            out = v;
+            return true;
+        }
+
+        // `p` から始まる 8 文字の 16 進数を変換する。大文字と小文字の両方を受け付ける。
+        inline bool parse_hex8(const char* p, std::uint64_t& out) noexcept
+        {
+            const auto v = swar_load8(p);
+            if( (v & swar_high_bits) != 0U )
+            {
+                return false;
+            }
+            const auto digit = swar_in_range(v, '0', '9');
+            const auto alpha = swar_in_range(v | swar_broadcast(0x20U), 'a', 'f');
+            if( (digit | alpha) != swar_high_bits )
+            {
+                return false;
+            }
+            // 英字は下位 4 ビットに 9 を足すと値になる
+            auto n = (v & swar_broadcast(0x0FU)) + ((alpha >> 7U) * 9U);
+            n = ((n << 4U) + (n >> 8U)) & 0x00FF00FF00FF00FFULL;
+            n = ((n << 8U) + (n >> 16U)) & 0x0000FFFF0000FFFFULL;
+            n = ((n << 16U) + (n >> 32U)) & 0x00000000FFFFFFFFULL;
+            out = n;
+            return true;
+        }
+
+#if defined(__SSE4_1__)
+        // `p` から始まる 16 文字の 10 進数を SSE4.1 で変換する。
+        inline bool parse_decimal16(const char* p, std::uint64_t& out) noexcept
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i_u*>(p));
+            const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+            const __m128i nine = _mm_set1_epi8(9);
+            if( _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) != 0xFFFF )
+            {
+                return false;
+            }
+            const __m128i pairs = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010A));
+            const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010064));
+            const __m128i packed = _mm_packus_epi32(quads, quads);
+            const __m128i octs = _mm_madd_epi16(packed, _mm_set1_epi32(0x00012710));
+            const auto hi = static_cast<std::uint32_t>(_mm_cvtsi128_si32(octs));
+            const auto lo = static_cast<std::uint32_t>(_mm_extract_epi32(octs, 1));
+            out = (std::uint64_t{ hi } * 100000000U) + lo;
+            return true;
+        }
+
+        // `p` から始まる 16 文字の 16 進数を SSE4.1 で変換する。
+        inline bool parse_hex16(const char* p, std::uint64_t& out) noexcept
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i_u*>(p));
+            const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+            const __m128i alphas = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            const __m128i is_digit = _mm_cmpeq_epi8(_mm_max_epu8(digits, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+            const __m128i is_alpha = _mm_cmpeq_epi8(_mm_max_epu8(alphas, _mm_set1_epi8(5)), _mm_set1_epi8(5));
+            if( _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF )
+            {
+                return false;
+            }
+            const __m128i nibbles = _mm_blendv_epi8(_mm_add_epi8(alphas, _mm_set1_epi8(10)), digits, is_digit);
+            const __m128i bytes = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+            const __m128i packed = _mm_packus_epi16(bytes, bytes);
+            out = std::byteswap(static_cast<std::uint64_t>(_mm_cvtsi128_si64(packed)));
+            return true;
+        }
+#endif
+
+        // `n` 文字 ( `n <= 19` ) の 10 進数を変換する。
+        inline bool parse_decimal_digits(const char* p, std::size_t n, std::uint64_t& out) noexcept
+        {
+            std::uint64_t value = 0U;
+#if defined(__SSE4_1__)
+            if( n >= 16ZU )
+            {
+                if( !parse_decimal16(p, value) )
+                {
+                    return false;
+                }
+                p += 16;
+                n -= 16ZU;
+            }
+#endif
+            for( ; n >= 8ZU; p += 8, n -= 8ZU )
+            {
+                std::uint64_t chunk{};
+                if( !parse_decimal8(p, chunk) )
+                {
+                    return false;
+                }
+                value = (value * 100000000U) + chunk;
+            }
+            for( ; n > 0ZU; ++p, --n )
+            {
+                const auto d = static_cast<unsigned int>(static_cast<unsigned char>(*p)) - static_cast<unsigned int>('0');
+                if( d > 9U )
+                {
+                    return false;
+                }
+                value = (value * 10U) + d;
+            }
+            out = value;
+            return true;
+        }
+
+        // `n` 文字 ( `n <= 16` ) の 16 進数を変換する。
+        inline bool parse_hex_digits(const char* p, std::size_t n, std::uint64_t& out) noexcept
+        {
+            std::uint64_t value = 0U;
+#if defined(__SSE4_1__)
+            if( n == 16ZU )
+            {
+                return parse_hex16(p, out);
+            }
+#endif
+            for( ; n >= 8ZU; p += 8, n -= 8ZU )
+            {
+                std::uint64_t chunk{};
+                if( !parse_hex8(p, chunk) )
+                {
+                    return false;
+                }
+                value = (value << 32U) | chunk;
+            }
+            for( ; n > 0ZU; ++p, --n )
+            {
+                const auto c = static_cast<unsigned char>(*p);
+                const auto lower = static_cast<unsigned char>(c | 0x20U);
+                if( c >= '0' && c <= '9' )
+                {
+                    value = (value << 4U) | static_cast<std::uint64_t>(c - '0');
+                }
+                else if( lower >= 'a' && lower <= 'f' )
+                {
+                    value = (value << 4U) | static_cast<std::uint64_t>(lower - 'a' + 10);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            out = value;
+            return true;
+        }
+
+        // 8 桁以上の 10 進数・ 16 進数を `std::from_chars` を介さずに変換する。
+        // 変換できない、あるいは `T` の範囲外である場合は `false` を返し、エラーの詳細は呼び出し側が `std::from_chars` で求める。
+        template <class T>
+        bool integral_from_string_fast(std::string_view s, int base, T& value) noexcept
+        {
+            using U = std::make_unsigned_t<T>;
+            bool negative = false;
+            if constexpr( std::is_signed_v<T> )
+            {
+                if( base == 10 && s.starts_with('-') )
+                {
+                    negative = true;
+                    s.remove_prefix(1ZU);
+                }
+            }
+
+            std::uint64_t mag{};
+            if( base == 16 )
+            {
+                if( s.size() < 8ZU || s.size() > 16ZU || !parse_hex_digits(s.data(), s.size(), mag) )
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                if( s.size() < 8ZU || s.size() > 20ZU )
+                {
+                    return false;
+                }
+                // 19 桁までは `std::uint64_t` に収まる
+                const auto head = s.size() == 20ZU ? 19ZU : s.size();
+                if( !parse_decimal_digits(s.data(), head, mag) )
+                {
+                    return false;
+                }
+                if( head != s.size() )
+                {
+                    const auto d = static_cast<unsigned int>(static_cast<unsigned char>(s.back())) - static_cast<unsigned int>('0');
+                    if( d > 9U || mag > (std::numeric_limits<std::uint64_t>::max() - d) / 10U )
+                    {
+                        return false;
+                    }
+                    mag = (mag * 10U) + d;
+                }
+            }
+
+            // 負値の絶対値は最大値より 1 だけ大きくなれる
+            const auto limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1U : 0U);
+            if( mag > limit )
+            {
+                return false;
+            }
+            value = negative ? static_cast<T>(U{} - static_cast<U>(mag)) : static_cast<T>(mag);
+            return true;
+        }
+
+    } // namespace detail
     
     // 文字列から整数型 `T` に変換する。 `bool` 型は整数型に含まれない。
     // 10 進数または 16 進数表記を受け付ける。16進数表記の場合は `0x` で文字列が始まっている必要があり、16 進数の負値は変換できない。
     //
     // 文字列 `str` 全体が変換されなかった場合もエラーを返し、 `std::from_chars_result::ptr != str.cend()` となる。
+    //
+    // 64 ビット以下の型で 8 桁以上の数値は SWAR ( SSE4.1 が使えるときは SIMD ) で変換する。
+    // 失敗したときは `std::from_chars` で変換し直すため、エラーは常に `std::from_chars` と同じになる。
     template <class T>
     requires (
         std::integral<T> &&
@@ -32,6 +295,16 @@ namespace col {
         }();
 
         T value{};
+        if constexpr( sizeof(T) <= sizeof(std::uint64_t) )
+        {
+            if !consteval
+            {
+                if( detail::integral_from_string_fast(s, base, value) )
+                {
+                    return value;
+                }
+            }
+        }
         const auto res = std::from_chars(s.cbegin(), s.cend(), value, base);
         if( res.ptr == s.cend() && res.ec == std::errc{} )
         {
@@ -91,4 +364,66 @@ namespace col {
         }
     }
 
+    // 区切り文字で区切られた数値の列のうち、変換に失敗した要素とそのエラー。
+    struct NumberListError
+    {
+        // 変換に失敗した要素。
+        std::string_view element;
+        std::from_chars_result result;
+    };
+
+    // 文字列 `str` を区切り文字 `delimiter` で区切ったときの要素数を得る。空文字列は要素を持たない。
+    constexpr std::size_t number_list_size(std::string_view str, char delimiter) noexcept
+    {
+        if( str.empty() )
+        {
+            return 0ZU;
+        }
+        return static_cast<std::size_t>(std::ranges::count(str, delimiter)) + 1ZU;
+    }
+
+    // 文字列 `str` を区切り文字 `delimiter` で区切り、各要素を `number_from_string<T>` で変換して先頭から順に `out` に書き込む。
+    // 空文字列は要素を持たない列とみなす。空の要素は変換に失敗する。
+    //
+    // 成功した場合は書き込み終えた位置を返す。失敗した場合は最初に失敗した要素で打ち切り、その要素とエラーを返す。
+    //
+    // 要素は 1 つずつ `number_from_string<T>` で変換するため、 8 桁以上の整数の要素はそれぞれ SWAR で変換される。
+    // 複数の要素をまとめて 1 つのレジスタで変換することはしない。
+    template <class T, std::output_iterator<const T&> O>
+    requires (
+        (
+            std::integral<T> &&
+            !std::same_as<std::decay_t<T>, bool>
+        ) ||
+        std::floating_point<T>
+    )
+    constexpr std::expected<O, NumberListError> number_list_from_string(std::string_view str, char delimiter, O out)
+    {
+        if( str.empty() )
+        {
+            return out;
+        }
+        while( true )
+        {
+            const auto pos = str.find(delimiter);
+            const auto element = str.substr(0ZU, pos);
+            const auto res = number_from_string<T>(element);
+            if( !res.has_value() )
+            {
+                return std::unexpected{
+                    NumberListError{
+                        .element = element,
+                        .result = res.error(),
+                    }
+                };
+            }
+            *out++ = *res;
+            if( pos == std::string_view::npos )
+            {
+                return out;
+            }
+            str.remove_prefix(pos + 1ZU);
+        }
+    }
+
 } // namespace col
@@ -5,6 +5,8 @@
 #include <memory>
 #include <type_traits>
 
+#include <col/optional.h>
+
 namespace col {
 
     // 非 nullptr が確実に格納されているポインタ型
@@ -16,7 +18,14 @@ namespace col {
     requires (std::is_object_v<T> && !std::same_as<T, std::nullptr_t>)
     class NonNull
     {
+        friend struct sentinel_nullable_traits<NonNull>;
+
         T* m_ptr;
+
+        // `col::optional` の番兵値とする `nullptr` を保持した値を構築する。
+        constexpr explicit NonNull(std::nullptr_t) noexcept
+        : m_ptr{ nullptr }
+        {}
     public:
         using value_type = T;
 
@@ -53,4 +62,13 @@ namespace col {
     template <class T>
     NonNull(T&) -> NonNull<T>;
 
+    // `NonNull` に対する `sentinel_nullable_traits` の特殊化。
+    // 有効値が取り得ない `nullptr` を番兵値に使用する。
+    template <class T>
+    requires (std::is_object_v<T> && !std::same_as<T, std::nullptr_t>)
+    struct sentinel_nullable_traits<NonNull<T>>
+    {
+        static constexpr NonNull<T> sentinel_value = NonNull<T>{ nullptr };
+    };
+
 } // namespace col
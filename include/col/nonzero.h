@@ -4,7 +4,7 @@
 #include <cstdint>
 #include <concepts>
 
-#include <optional>
+#include <col/optional.h>
 
 namespace col {
 
@@ -22,7 +22,8 @@ namespace col {
     public:
 
         // 整数型 `T` から `NonZero<T>` を生成する。 `value != 0` のときに有効値を返す。
-        static constexpr std::optional<NonZero<T>> make_nonzero(T value) noexcept
+        // 戻り値の `col::optional` は `0` を無効値として使用するため、 `NonZero<T>` と同じ大きさになる。
+        static constexpr col::optional<NonZero<T>, true> make_nonzero(T value) noexcept
         {
             if( value != 0 )
             {
@@ -61,4 +62,13 @@ namespace col {
     using NonZeroIsize = NonZero<std::ptrdiff_t>;
     using NonZeroUsize = NonZero<std::size_t>;
 
+    // `NonZero` に対する `sentinel_nullable_traits` の特殊化。
+    // 有効値が取り得ない `0` を番兵値に使用する。
+    template <class T>
+    requires (std::integral<T>)
+    struct sentinel_nullable_traits<NonZero<T>>
+    {
+        static constexpr NonZero<T> sentinel_value = NonZero<T>::make_nonzero_unchecked(0);
+    };
+
 } // namespace col
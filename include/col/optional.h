@@ -1,15 +1,21 @@
 #pragma once
 
+#include <cstdint>
+
+#include <array>
+#include <bit>
 #include <concepts>
 #include <exception>
 #include <functional>
 #include <initializer_list>
+#include <limits>
 #include <memory>
 #include <new>
 #include <optional>
 #include <type_traits>
 #include <utility>
 
+#include <col/relocate.h>
 #include <col/type_traits.h>
 
 namespace col {
@@ -53,11 +59,150 @@ namespace col {
             std::is_constructible_v<T, decltype(sentinel_nullable_traits<T>::sentinel_value)>; // TODO
         };
 
+    // ニッチベースの Nullable 最適化に用いる、 `col::optional<T>` の記憶域。
+    //
+    // 有効値を保持している間は `value` が生存している。
+    // 無効値を保持している間は `niche_traits<T>::set_niche` が書き込んだ `value` または `niche` のどちらかが生存している。
+    template <class T>
+    union niche_storage
+    {
+        // 生の記憶域。 `T` の値として取り得ないビット列を無効値に使う場合に用いる。
+        std::array<unsigned char, sizeof(T)> niche;
+        // 有効値。
+        T value;
+
+        // `niche` を生存させた状態で構築する。
+        constexpr niche_storage() noexcept
+        : niche{}
+        {}
+
+        constexpr niche_storage(const niche_storage&) = default;
+        constexpr niche_storage(niche_storage&&) = default;
+        constexpr niche_storage& operator=(const niche_storage&) = default;
+        constexpr niche_storage& operator=(niche_storage&&) = default;
+
+        // `value` の破棄は `col::optional<T>` が行う。
+        constexpr ~niche_storage()
+        {}
+
+        constexpr ~niche_storage()
+            requires(std::is_trivially_destructible_v<T>)
+        = default;
+    };
+
+    // ニッチベースの Nullable 最適化が可能な型に対するトレイト型。
+    //
+    // 特殊化は以下の静的メンバ関数を持たなければならない。
+    // - `static constexpr bool is_niche(const niche_storage<T>& s) noexcept` : `s` が無効値を表していれば `true` を返す。
+    // - `static constexpr void set_niche(niche_storage<T>& s) noexcept` : 有効値を保持していない `s` に無効値を書き込む。
+    //
+    // `T` が非トリビアルなデストラクタを持つ場合、 `set_niche` は `s.value` を生存させなければならない。
+    template <class T>
+    struct niche_traits{};
+
+    // `sentinel_nullable_optimizable` を満たす型 `T` に対する `niche_traits` の特殊化。
+    // 番兵値を `T` の値として構築し、無効値とする。
+    template <class T>
+    requires (sentinel_nullable_optimizable<T>)
+    struct niche_traits<T>
+    {
+        static constexpr bool is_niche(const niche_storage<T>& s) noexcept
+        {
+            return s.value == sentinel_nullable_traits<T>::sentinel_value;
+        }
+        static constexpr void set_niche(niche_storage<T>& s) noexcept
+        {
+            std::construct_at(std::addressof(s.value), sentinel_nullable_traits<T>::sentinel_value);
+        }
+    };
+
+    // 浮動小数点数型に対する `niche_traits` の特殊化。
+    // 演算の結果としては生じない signaling NaN のうち、特定のペイロードを持つビット列を無効値とする。
+    // そのため、同じビット列の値を有効値として保持することはできない。
+    template <class T>
+    requires (
+        (std::same_as<T, float> || std::same_as<T, double>) &&
+        std::numeric_limits<T>::is_iec559 &&
+        !sentinel_nullable_optimizable<T>)
+    struct niche_traits<T>
+    {
+        // `T` と同じ大きさの符号なし整数型。
+        using bits_type = std::conditional_t<sizeof(T) == 4ZU, std::uint32_t, std::uint64_t>;
+
+        // 無効値のビット列。
+        static constexpr bits_type niche_bits = sizeof(T) == 4ZU
+            ? static_cast<bits_type>(0x7FA0'0C01U)
+            : static_cast<bits_type>(0x7FF4'0000'0000'0C01U);
+
+        static constexpr bool is_niche(const niche_storage<T>& s) noexcept
+        {
+            return std::bit_cast<bits_type>(s.value) == niche_bits;
+        }
+        static constexpr void set_niche(niche_storage<T>& s) noexcept
+        {
+            std::construct_at(std::addressof(s.value), std::bit_cast<T>(niche_bits));
+        }
+    };
+
+    // `bool` に対する `niche_traits` の特殊化。
+    // `false` と `true` のどちらでもないバイト値を無効値とする。
+    //
+    // 定数式の中では、 `value` が生存しているかを `__builtin_is_within_lifetime` で判定する。
+    template <>
+    struct niche_traits<bool>
+    {
+        // 無効値のバイト値。
+        static constexpr unsigned char niche_byte = 0x02U;
+
+        static constexpr bool is_niche(const niche_storage<bool>& s) noexcept
+        {
+#if __has_builtin(__builtin_is_within_lifetime)
+            if consteval
+            {
+                return !__builtin_is_within_lifetime(std::addressof(s.value));
+            }
+#endif
+            return std::bit_cast<unsigned char>(s) == niche_byte;
+        }
+        static constexpr void set_niche(niche_storage<bool>& s) noexcept
+        {
+            s.niche = std::array<unsigned char, 1ZU>{ niche_byte };
+        }
+    };
+
+    // 列挙型 `E` の列挙子が取らない値 `Niche` を無効値とする `niche_traits` の実装。
+    // `niche_traits<E>` をこの型から派生して特殊化することで、 `col::optional<E>` が最適化される。
+    // `E` は基底型が固定された列挙型でなければならない。
+    template <class E, std::underlying_type_t<E> Niche>
+    requires (std::is_enum_v<E>)
+    struct enum_niche_traits
+    {
+        static constexpr bool is_niche(const niche_storage<E>& s) noexcept
+        {
+            return std::to_underlying(s.value) == Niche;
+        }
+        static constexpr void set_niche(niche_storage<E>& s) noexcept
+        {
+            std::construct_at(std::addressof(s.value), static_cast<E>(Niche));
+        }
+    };
+
+    // ニッチベースの Nullable 最適化が可能な型であることを示すコンセプト。
+    // `sentinel_nullable_optimizable` を満たす型、 `float` 、 `double` 、 `bool` と、
+    // `niche_traits` を特殊化した型がこのコンセプトを満たす。
+    template <class T>
+    concept niche_optimizable =
+        std::is_object_v<T> &&
+        requires (niche_storage<T>& s, const niche_storage<T>& cs) {
+            { niche_traits<T>::is_niche(cs) } -> std::same_as<bool>;
+            niche_traits<T>::set_niche(s);
+        };
+
     // Nullable 最適化が可能な `optional` 型。
     // `std::optional` と互換のインターフェースを持つ。
-    // `T` が `sentinel_nullable_optimizable` を満たす場合、無効値の領域が最適化される。
+    // `T` が `niche_optimizable` を満たす場合、無効値の領域が最適化される。
     // `Optimized` へ明示的に `false` を指定することで、 `T` によらず無効値の領域は最適化されない。
-    template <class T, bool Optimized = sentinel_nullable_optimizable<T>>
+    template <class T, bool Optimized = niche_optimizable<T>>
     class optional;
 
     namespace detail {
@@ -210,8 +355,8 @@ namespace col {
         {}
 
         /* デストラクタ */
-        constexpr ~optional()
-        {}
+        // 有効値の破棄は `std::optional<T>` が行うため、 `T` がトリビアルに破棄可能であればトリビアルになる。
+        constexpr ~optional() = default;
 
         /* 代入演算子 */
 
@@ -666,10 +811,10 @@ namespace col {
         }
     };
 
-    // `sentinel_nullable_optimizable` コンセプトを満たす型 `T` に対する `optional` の特殊化。
+    // `niche_optimizable` コンセプトを満たす型 `T` に対する `optional` の特殊化。
     // Nullable 最適化により無効値の領域が最適化される。
     template <class T>
-    requires (sentinel_nullable_optimizable<T>)
+    requires (niche_optimizable<T>)
     class optional<T, true>
     {
         static_assert(std::is_reference_v<T> == false, "T must not be a reference type");
@@ -677,30 +822,58 @@ namespace col {
         static_assert(std::same_as<std::remove_cv_t<T>, std::nullopt_t> == false, "T must not be std::nullopt_t");
         static_assert(std::destructible<T>);
 
-        T m_value;
+        niche_storage<T> m_storage;
+
+        // 有効値を保持していない状態で `T` の値を構築する。
+        template <class ...Args>
+        constexpr void construct_value(Args&& ...args)
+            noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        {
+            if constexpr( !std::is_trivially_destructible_v<T> )
+            {
+                m_storage.value.~T();
+            }
+            std::construct_at(std::addressof(m_storage.value), std::forward<Args>(args)...);
+        }
+
+        // 有効値を保持していればそれへ代入し、保持していなければ `T` の値を構築する。
+        template <class U>
+        constexpr void assign_value(U&& v)
+            noexcept(std::is_nothrow_assignable_v<T&, U> && std::is_nothrow_constructible_v<T, U>)
+        {
+            if( has_value() )
+            {
+                m_storage.value = std::forward<U>(v);
+            }
+            else
+            {
+                construct_value(std::forward<U>(v));
+            }
+        }
     public:
         // 要素型
         // ポインタ型や `std::optional` についてはそれが扱う要素型。
         using value_type = unwrap_pointer_like_t<T>;
 
-        // 番兵型
-        using sentinel_type = decltype(sentinel_nullable_traits<T>::sentinel_value);
+        // 無効値の表現を定めるトレイト型
+        using traits_type = niche_traits<T>;
 
-        // 番兵値
-        static constexpr sentinel_type sentinel_value = sentinel_nullable_traits<T>::sentinel_value;
-        
 
         /* コンストラクタ */
 
         // 無効値を保持した状態で構築する
         constexpr optional() noexcept
-        : m_value(sentinel_value)
-        {}
+        : m_storage()
+        {
+            traits_type::set_niche(m_storage);
+        }
 
         // 無効値を保持した状態で構築する
         constexpr optional(std::nullopt_t) noexcept
-        : m_value(sentinel_value)
-        {}
+        : m_storage()
+        {
+            traits_type::set_niche(m_storage);
+        }
 
         // 有効値を `rhs` が保持していたらそれをコピーする
         constexpr optional(const optional& rhs)
@@ -708,8 +881,17 @@ namespace col {
             requires(
                 std::is_copy_constructible_v<T> &&
                 !std::is_trivially_copy_constructible_v<T>)
-        : m_value(rhs.m_value)
-        {}
+        : m_storage()
+        {
+            if( rhs.has_value() )
+            {
+                std::construct_at(std::addressof(m_storage.value), rhs.m_storage.value);
+            }
+            else
+            {
+                traits_type::set_niche(m_storage);
+            }
+        }
 
         // `T` がコピー構築不可なら `delete` 定義
         constexpr optional(const optional& rhs)
@@ -727,8 +909,17 @@ namespace col {
             requires(
                 std::is_move_constructible_v<T> &&
                 !std::is_trivially_move_constructible_v<T>)
-        : m_value(std::move(rhs.m_value))
-        {}
+        : m_storage()
+        {
+            if( rhs.has_value() )
+            {
+                std::construct_at(std::addressof(m_storage.value), std::move(rhs.m_storage.value));
+            }
+            else
+            {
+                traits_type::set_niche(m_storage);
+            }
+        }
 
         // `T` がトリビアルにムーブ構築可能なら `default` 定義
         constexpr optional(optional&& rhs) noexcept
@@ -745,16 +936,20 @@ namespace col {
         requires (std::is_constructible_v<T, Args...>)
         explicit constexpr optional(std::in_place_t, Args&& ...args)
             noexcept(std::is_nothrow_constructible_v<T, Args...>)
-        : m_value(std::forward<Args>(args)...)
-        {}
+        : m_storage()
+        {
+            std::construct_at(std::addressof(m_storage.value), std::forward<Args>(args)...);
+        }
 
         // 型 `T` のコンストラクタ引数として初期化子リストと任意個の引数を受け取って `T` の値を生成し有効値として保持する。
         template <class U, class ...Args>
         requires (std::is_constructible_v<T, std::initializer_list<U>&, Args...>)
         explicit constexpr optional(std::in_place_t, std::initializer_list<U> il, Args&& ...args)
             noexcept(std::is_nothrow_constructible_v<T, std::initializer_list<U>&, Args...>) // TODO
-        : m_value(il, std::forward<Args>(args)...)
-        {}
+        : m_storage()
+        {
+            std::construct_at(std::addressof(m_storage.value), il, std::forward<Args>(args)...);
+        }
 
         // 型 `T` に変換可能な型 `U` をムーブして有効値として保持する。
         template <class U = T>
@@ -764,8 +959,10 @@ namespace col {
         explicit(!std::is_convertible_v<U, T>)
         constexpr optional(U&& rhs)
             noexcept(std::is_move_constructible_v<T>) // TODO
-        : m_value(std::move(rhs))
-        {}
+        : m_storage()
+        {
+            std::construct_at(std::addressof(m_storage.value), std::move(rhs));
+        }
 
         // 変換可能な `optional` からコピー構築する。
         template <class U>
@@ -775,8 +972,17 @@ namespace col {
         explicit(!std::is_convertible_v<U&, T>)
         constexpr optional(const optional<U>& rhs)
             noexcept(std::is_copy_constructible_v<T>) // TODO
-        : m_value(rhs.m_value)
-        {}
+        : m_storage()
+        {
+            if( rhs.has_value() )
+            {
+                std::construct_at(std::addressof(m_storage.value), rhs.value());
+            }
+            else
+            {
+                traits_type::set_niche(m_storage);
+            }
+        }
 
         // 変換可能な `optional` からムーブ構築する。
         template <class U>
@@ -786,13 +992,23 @@ namespace col {
         explicit(!std::is_convertible_v<U&&, T>)
         constexpr optional(optional<U>&& rhs)
             noexcept(std::is_move_constructible_v<T>) // TODO
-        : m_value(std::move(rhs.m_value))
-        {}
+        : m_storage()
+        {
+            if( rhs.has_value() )
+            {
+                std::construct_at(std::addressof(m_storage.value), std::move(rhs.value()));
+            }
+            else
+            {
+                traits_type::set_niche(m_storage);
+            }
+        }
 
         /* デストラクタ */
+        // `T` が非トリビアルなデストラクタを持つ場合、 `niche_traits<T>` の要件により `m_storage.value` は常に生存している。
         constexpr ~optional()
         {
-            m_value.~T();
+            m_storage.value.~T();
         }
 
         // `T` がトリビアルに破棄可能だった場合は `default` 実装。
@@ -805,7 +1021,7 @@ namespace col {
         // 無効値を代入する
         constexpr optional& operator=(std::nullopt_t) noexcept
         {
-            m_value = sentinel_value;
+            reset();
             return *this;
         }
 
@@ -813,7 +1029,14 @@ namespace col {
         constexpr optional& operator=(const optional& rhs)
             noexcept(std::is_nothrow_copy_assignable_v<T>)
         {
-            m_value = rhs.m_value;
+            if( rhs.has_value() )
+            {
+                assign_value(rhs.m_storage.value);
+            }
+            else
+            {
+                reset();
+            }
             return *this;
         }
 
@@ -836,7 +1059,14 @@ namespace col {
         constexpr optional& operator=(optional&& rhs)
             noexcept(std::is_move_constructible_v<T>)
         {
-            m_value = std::move(rhs.m_value);
+            if( rhs.has_value() )
+            {
+                assign_value(std::move(rhs.m_storage.value));
+            }
+            else
+            {
+                reset();
+            }
             return *this;
         }
 
@@ -859,9 +1089,9 @@ namespace col {
         template <class U = T>
         requires (std::is_convertible_v<U&&, T>)
         constexpr optional operator=(U&& rhs)
-            noexcept(m_value.operator=(std::forward<U>(rhs))) // TODO
+            noexcept(std::is_nothrow_assignable_v<T&, U> && std::is_nothrow_constructible_v<T, U>)
         {
-            m_value = std::forward<U>(rhs);
+            assign_value(std::forward<U>(rhs));
             return *this;
         }
     
@@ -869,9 +1099,16 @@ namespace col {
         template <class U = T>
         requires (std::is_convertible_v<U&, T>)
         constexpr optional operator=(const optional<U>& rhs)
-            noexcept(m_value.operator=(rhs.m_value)) // TODO
+            noexcept(std::is_nothrow_assignable_v<T&, const U&> && std::is_nothrow_constructible_v<T, const U&>)
         {
-            m_value = rhs.m_value;
+            if( rhs.has_value() )
+            {
+                assign_value(rhs.value());
+            }
+            else
+            {
+                reset();
+            }
             return *this;
         }
     
@@ -879,9 +1116,16 @@ namespace col {
         template <class U = T>
         requires (std::is_convertible_v<U&&, T>)
         constexpr optional operator=(optional<U>&& rhs)
-            noexcept(m_value.operator=(std::move(rhs.m_value))) // TODO
+            noexcept(std::is_nothrow_assignable_v<T&, U> && std::is_nothrow_constructible_v<T, U>)
         {
-            m_value = std::move(rhs.m_value);
+            if( rhs.has_value() )
+            {
+                assign_value(std::move(rhs.value()));
+            }
+            else
+            {
+                reset();
+            }
             return *this;
         }
 
@@ -893,9 +1137,8 @@ namespace col {
         constexpr T& emplace(Args&& ...args)
             noexcept(false) // TODO
         {
-            m_value.~T();
-            std::construct_at(&m_value, std::forward<Args>(args)...);
-            return *std::launder(&m_value);
+            construct_value(std::forward<Args>(args)...);
+            return m_storage.value;
         }
 
         // 要素型のコンストラクタ引数から直接構築し、構築された有効値への参照を返す。
@@ -907,9 +1150,8 @@ namespace col {
         constexpr T& emplace(std::initializer_list<U> il, Args&& ...args)
             noexcept(false) // TODO
         {
-            m_value.~T();
-            std::construct_at(&m_value, il, std::forward<Args>(args)...);
-            return *std::launder(*m_value);
+            construct_value(il, std::forward<Args>(args)...);
+            return m_storage.value;
         }
 
         // 他の `optional` と値を入れ替える。
@@ -926,28 +1168,30 @@ namespace col {
             const auto rhs_has = rhs.has_value();
             if( self_has && rhs_has )
             {
-                if( rhs_has )
-                {
-                    std::swap(value(), rhs.value());
-                }
-                else
-                {
-                    rhs.m_value = std::move(m_value);
-                    reset();
-                }
+                using std::swap;
+                swap(m_storage.value, rhs.m_storage.value);
+            }
+            else if( self_has )
+            {
+                rhs.construct_value(std::move(m_storage.value));
+                reset();
             }
             else if( rhs_has )
             {
-                m_value = std::move(rhs.m_value);
+                construct_value(std::move(rhs.m_storage.value));
                 rhs.reset();
             }
         }
 
         // 有効値を保持していない状態にする。
-        // 有効値を保持していないとき、および `T` が非トリビアルなデストラクタを持っている場合は何もしない。
+        // 有効値を保持していれば破棄し、 `niche_traits<T>::set_niche` で無効値を書き込む。
         constexpr void reset() noexcept
         {
-            m_value = sentinel_value;
+            if constexpr( !std::is_trivially_destructible_v<T> )
+            {
+                m_storage.value.~T();
+            }
+            traits_type::set_niche(m_storage);
         }
 
         /* 値の観測 */
@@ -955,7 +1199,7 @@ namespace col {
         // 有効値を保持しているか判定する
         constexpr bool has_value() const noexcept
         {
-            return m_value != sentinel_value;
+            return !traits_type::is_niche(m_storage);
         }
 
         // 有効値を取得する。有効値を保持していない場合は未定義動作を引き起こす。
@@ -963,11 +1207,11 @@ namespace col {
         {
             if constexpr(std::is_pointer_v<T> || is_std_optional_v<T>)
             {
-                return *m_value;
+                return *m_storage.value;
             }
             else
             {
-                return m_value;
+                return m_storage.value;
             }
         }
 
@@ -976,11 +1220,11 @@ namespace col {
         {
             if constexpr(std::is_pointer_v<T> || is_std_optional_v<T>)
             {
-                return *m_value;
+                return *m_storage.value;
             }
             else
             {
-                return m_value;
+                return m_storage.value;
             }
         }
 
@@ -989,11 +1233,11 @@ namespace col {
         {
             if constexpr(std::is_pointer_v<T> || is_std_optional_v<T>)
             {
-                return std::move(*m_value);
+                return std::move(*m_storage.value);
             }
             else
             {
-                return m_value;
+                return std::move(m_storage.value);
             }
         }
 
@@ -1002,11 +1246,11 @@ namespace col {
         {
             if constexpr(std::is_pointer_v<T> || is_std_optional_v<T>)
             {
-                return std::move(*m_value);
+                return std::move(*m_storage.value);
             }
             else
             {
-                return m_value;
+                return std::move(m_storage.value);
             }
         }
 
@@ -1015,11 +1259,15 @@ namespace col {
         {
             if constexpr( std::is_pointer_v<T> )
             {
-                return m_value;
+                return m_storage.value;
+            }
+            else if constexpr( is_std_optional_v<T> )
+            {
+                return m_storage.value.operator->();
             }
             else
             {
-                return m_value.operator->();
+                return std::addressof(m_storage.value);
             }
         }
 
@@ -1028,11 +1276,15 @@ namespace col {
         {
             if constexpr( std::is_pointer_v<T> )
             {
-                return m_value;
+                return m_storage.value;
+            }
+            else if constexpr( is_std_optional_v<T> )
+            {
+                return m_storage.value.operator->();
             }
             else
             {
-                return m_value.operator->();
+                return std::addressof(m_storage.value);
             }
         }
 
@@ -1042,7 +1294,7 @@ namespace col {
         {
             if( has_value() ) [[likely]]
             {
-                return m_value;
+                return m_storage.value;
             }
             else
             {
@@ -1056,7 +1308,7 @@ namespace col {
         {
             if( has_value() ) [[likely]]
             {
-                return m_value;
+                return m_storage.value;
             }
             else
             {
@@ -1070,7 +1322,7 @@ namespace col {
         {
             if( has_value() ) [[likely]]
             {
-                return m_value;
+                return std::move(m_storage.value);
             }
             else
             {
@@ -1084,7 +1336,7 @@ namespace col {
         {
             if( has_value() ) [[likely]]
             {
-                return m_value;
+                return std::move(m_storage.value);
             }
             else
             {
@@ -1350,8 +1602,213 @@ namespace col {
         }
     
     };
+
+    // 参照型 `T&` に対する `optional` の特殊化。
+    // 参照先のオブジェクトへのポインタだけを保持し、無効値には `optional<T*>` と同じく `nullptr` を使用する。
+    // 参照先の値はコピーせず、代入は参照先を付け替える。
+    template <class T>
+    class optional<T&, false>
+    {
+        static_assert(std::is_object_v<T> || std::is_function_v<T>, "T must be an object or function type");
+
+        template <class U, bool Optimized>
+        friend class optional;
+
+        optional<T*, true> m_ptr;
+    public:
+        // 要素型
+        using value_type = T;
+
+        /* コンストラクタ */
+
+        // 無効値を保持した状態で構築する
+        constexpr optional() noexcept
+        : m_ptr()
+        {}
+
+        // 無効値を保持した状態で構築する
+        constexpr optional(std::nullopt_t) noexcept
+        : m_ptr()
+        {}
+
+        constexpr optional(const optional&) noexcept = default;
+
+        // 左辺値 `ref` を参照する有効値を保持する。
+        template <class U>
+        requires (std::is_convertible_v<U*, T*>)
+        constexpr optional(U& ref) noexcept
+        : m_ptr(std::addressof(ref))
+        {}
+
+        // 一時オブジェクトへの参照は保持できない。
+        template <class U>
+        requires (!std::is_lvalue_reference_v<U> && std::is_convertible_v<std::remove_reference_t<U>*, T*>)
+        optional(U&& ref) = delete;
+
+        // 参照先の型が変換可能な `optional<U&>` から構築する。
+        template <class U>
+        requires (!std::same_as<U, T> && std::is_convertible_v<U*, T*>)
+        constexpr optional(const optional<U&>& rhs) noexcept
+        : m_ptr(rhs.m_ptr.has_value() ? static_cast<T*>(std::addressof(*rhs)) : nullptr)
+        {}
+
+        /* 代入演算子 */
+
+        constexpr optional& operator=(const optional&) noexcept = default;
+
+        // 無効値を代入する
+        constexpr optional& operator=(std::nullopt_t) noexcept
+        {
+            m_ptr.reset();
+            return *this;
+        }
+
+        // 左辺値 `ref` を参照するよう付け替え、参照先への参照を返す。
+        template <class U>
+        requires (std::is_convertible_v<U*, T*>)
+        constexpr T& emplace(U& ref) noexcept
+        {
+            m_ptr = static_cast<T*>(std::addressof(ref));
+            return ref;
+        }
+
+        // 他の `optional` と参照先を入れ替える。
+        constexpr void swap(optional& rhs) noexcept
+        {
+            std::swap(m_ptr, rhs.m_ptr);
+        }
+
+        // 有効値を保持していない状態にする。参照先のオブジェクトには影響しない。
+        constexpr void reset() noexcept
+        {
+            m_ptr.reset();
+        }
+
+        /* 値の観測 */
+
+        // 有効値を保持しているか判定する
+        constexpr bool has_value() const noexcept
+        {
+            return m_ptr.has_value();
+        }
+
+        // 有効値を保持しているか判定する
+        constexpr explicit operator bool() const noexcept
+        {
+            return has_value();
+        }
+
+        // 参照先を取得する。有効値を保持していない場合は未定義動作を引き起こす。
+        constexpr T& operator*() const noexcept
+        {
+            return *m_ptr.value();
+        }
+
+        // 参照先のメンバにアクセスする。有効値を保持していない場合は未定義動作を引き起こす。
+        constexpr T* operator->() const noexcept
+        {
+            return m_ptr.value();
+        }
+
+        // 参照先を取得する。有効値を保持していない場合は `std::terminate()` が呼ばれる。
+        constexpr T& value() const noexcept
+        {
+            if( has_value() ) [[likely]]
+            {
+                return **this;
+            }
+            else
+            {
+                std::terminate();
+            }
+        }
+
+        // 有効値を保持していれば参照先の値のコピーを、保持していなければ `v` を返す。
+        template <class U>
+        constexpr std::remove_cv_t<T> value_or(U&& v) const
+            noexcept(std::is_nothrow_copy_constructible_v<std::remove_cv_t<T>> && std::is_nothrow_constructible_v<std::remove_cv_t<T>, U>)
+        {
+            static_assert(std::is_convertible_v<U&&, std::remove_cv_t<T>>);
+            return has_value() ? **this : static_cast<std::remove_cv_t<T>>(std::forward<U>(v));
+        }
+
+        /* モナド操作 */
+
+        // 有効値を保持していれば、参照先に対して `f` を適用した結果を `optional` として返す。
+        // 有効値を保持していなければ、無効値を返す。
+        // `F` は `T&` を受け取り `optional` を返す関数でなければならない。
+        template <class F>
+        requires (std::invocable<F, T&>)
+        constexpr auto and_then(F&& f) const
+            noexcept(std::is_nothrow_invocable_v<F, T&>)
+        {
+            using U = std::invoke_result_t<F, T&>;
+            static_assert(
+                col::is_col_optional_v<std::remove_cvref_t<U>>,
+                "function's return type is not a specialized type of col::optional");
+            if( has_value() )
+            {
+                return std::invoke(std::forward<F>(f), **this);
+            }
+            else
+            {
+                return std::remove_cvref_t<U>();
+            }
+        }
+
+        // 有効値を保持していれば、参照先に対して `f` を適用した結果を `optional` に格納して返す。
+        // 有効値を保持していなければ、無効値を返す。
+        // `f` が左辺値参照を返す場合は、その参照先を参照する `optional<U&>` を返す。
+        template <class F>
+        requires (std::invocable<F, T&>)
+        constexpr auto transform(F&& f) const
+            noexcept(std::is_nothrow_invocable_v<F, T&>)
+        {
+            using U = std::invoke_result_t<F, T&>;
+            using R = std::conditional_t<std::is_lvalue_reference_v<U>, optional<U>, optional<std::remove_cv_t<U>>>;
+            static_assert(!std::same_as<std::remove_cvref_t<U>, std::in_place_t>);
+            static_assert(!std::same_as<std::remove_cvref_t<U>, std::nullopt_t>);
+            static_assert(!std::is_array_v<std::remove_reference_t<U>>);
+
+            if( has_value() )
+            {
+                return R(std::invoke(std::forward<F>(f), **this));
+            }
+            else
+            {
+                return R();
+            }
+        }
+
+        // 有効値を保持していれば、自身を返す。有効値を保持していなければ、 `F` の呼び出し結果を `optional` として返す。
+        // `F` は `optional` を返す関数でなければならない。
+        template <class F>
+        requires (std::invocable<F>)
+        constexpr optional or_else(F&& f) const
+            noexcept(std::is_nothrow_invocable_v<F>)
+        {
+            static_assert(std::same_as<std::remove_cvref_t<std::invoke_result_t<F>>, optional>);
+            if( has_value() )
+            {
+                return *this;
+            }
+            else
+            {
+                return std::invoke(std::forward<F>(f));
+            }
+        }
+    };
     
 
+    // `col::optional` に対する `is_trivially_relocatable` の特殊化。
+    // 有効値の有無を表す領域は自身のアドレスに依存しないため、 `T` がトリビアルに再配置可能であれば `optional` も同様。
+    template <class T, bool Optimized>
+    struct is_trivially_relocatable<optional<T, Optimized>> : is_trivially_relocatable<std::remove_cv_t<T>> {};
+
+    // 参照の `optional` はポインタのみを保持するため、常にトリビアルに再配置可能。
+    template <class T>
+    struct is_trivially_relocatable<optional<T&, false>> : std::true_type {};
+
     // 2 つの `col::optional<T>` の価を入れ替える。
     template <class T>
     requires (std::is_swappable_v<T> || std::is_move_constructible_v<T>)
@@ -1434,6 +1891,6 @@ namespace col {
 
     // deduction guide
     template <class T>
-    optional(T) -> optional<T, sentinel_nullable_optimizable<T>>;
+    optional(T) -> optional<T, niche_optimizable<T>>;
 
 } // namespace col
@@ -0,0 +1,608 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <col/optional.h>
+
+namespace col {
+
+    template <class T>
+    class optional_vector;
+
+    namespace detail {
+
+        // `optional_vector` の有効値の有無を 1 ビットずつ詰めて保持するワードの型。
+        using optional_vector_word = std::uint64_t;
+
+        // 1 ワードあたりのビット数。
+        inline constexpr std::size_t OptionalVectorWordBits = 64ZU;
+
+        // `count` 個の要素を表すのに必要なワード数。
+        constexpr std::size_t optional_vector_words(std::size_t count) noexcept
+        {
+            return (count + OptionalVectorWordBits - 1ZU) / OptionalVectorWordBits;
+        }
+
+        // `optional_vector` の要素 1 つを参照するプロキシ。
+        // `col::optional<T&>` と同じように、有効値の有無の観測と有効値への参照の取得ができる。
+        template <class T, bool Const>
+        class optional_vector_reference
+        {
+            using value_pointer = std::conditional_t<Const, const T*, T*>;
+            using word_pointer = std::conditional_t<Const, const optional_vector_word*, optional_vector_word*>;
+
+            value_pointer m_value;
+            word_pointer m_word;
+            optional_vector_word m_mask;
+
+        public:
+            using value_type = T;
+
+            constexpr optional_vector_reference(value_pointer value, word_pointer word, optional_vector_word mask) noexcept
+            : m_value{ value }
+            , m_word{ word }
+            , m_mask{ mask }
+            {}
+
+            // 代入は参照先に書き込むため、コピーでは参照先だけを引き継ぐ。
+            constexpr optional_vector_reference(const optional_vector_reference&) noexcept = default;
+
+            // 変更可能なプロキシから読み取り専用のプロキシへ変換する。
+            constexpr operator optional_vector_reference<T, true>() const noexcept
+                requires(!Const)
+            {
+                return optional_vector_reference<T, true>{ m_value, m_word, m_mask };
+            }
+
+            // 有効値を保持しているか判定する
+            constexpr bool has_value() const noexcept
+            {
+                return (*m_word & m_mask) != 0U;
+            }
+
+            // 有効値を保持しているか判定する
+            constexpr explicit operator bool() const noexcept
+            {
+                return has_value();
+            }
+
+            // 有効値を取得する。有効値を保持していない場合は未定義動作を引き起こす。
+            constexpr auto& operator*() const noexcept
+            {
+                return *m_value;
+            }
+
+            // 保持している有効値のメンバにアクセスする。有効値を保持していない場合は未定義動作を引き起こす。
+            constexpr value_pointer operator->() const noexcept
+            {
+                return m_value;
+            }
+
+            // 有効値を取得する。有効値を保持していない場合は `std::terminate()` が呼ばれる。
+            constexpr auto& value() const noexcept
+            {
+                if( has_value() ) [[likely]]
+                {
+                    return *m_value;
+                }
+                else
+                {
+                    std::terminate();
+                }
+            }
+
+            // 有効値を保持していればその有効値を、保持していなければ `v` を返す。
+            template <class U>
+            constexpr T value_or(U&& v) const
+                noexcept(std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_constructible_v<T, U>)
+            {
+                static_assert(std::is_convertible_v<U&&, T>);
+                return has_value() ? *m_value : static_cast<T>(std::forward<U>(v));
+            }
+
+            // 有効値を保持していれば、その値に対して `f` を適用した結果を `optional` として返す。
+            // 有効値を保持していなければ、無効値を返す。
+            template <class F>
+            constexpr auto and_then(F&& f) const
+                noexcept(std::is_nothrow_invocable_v<F, decltype(*m_value)>)
+            {
+                using U = std::invoke_result_t<F, decltype(*m_value)>;
+                static_assert(
+                    col::is_col_optional_v<std::remove_cvref_t<U>>,
+                    "function's return type is not a specialized type of col::optional");
+                if( has_value() )
+                {
+                    return std::invoke(std::forward<F>(f), *m_value);
+                }
+                else
+                {
+                    return std::remove_cvref_t<U>();
+                }
+            }
+
+            // 有効値を保持していれば、その値に対して `f` を適用した結果を `optional` に格納して返す。
+            // 有効値を保持していなければ、無効値を返す。
+            template <class F>
+            constexpr auto transform(F&& f) const
+                noexcept(std::is_nothrow_invocable_v<F, decltype(*m_value)>)
+            {
+                using U = std::remove_cv_t<std::invoke_result_t<F, decltype(*m_value)>>;
+                if( has_value() )
+                {
+                    return col::optional<U>(std::invoke(std::forward<F>(f), *m_value));
+                }
+                else
+                {
+                    return col::optional<U>();
+                }
+            }
+
+            // 値をコピーした `col::optional<T>` に変換する。
+            constexpr operator col::optional<T>() const
+                noexcept(std::is_nothrow_copy_constructible_v<T>)
+            {
+                return has_value() ? col::optional<T>(*m_value) : col::optional<T>();
+            }
+
+            // 無効値を代入する。値の領域はそのまま残る。
+            constexpr const optional_vector_reference& operator=(std::nullopt_t) const noexcept
+                requires(!Const)
+            {
+                *m_word &= ~m_mask;
+                return *this;
+            }
+
+            // 別の要素の有効値の有無と、有効値を保持していればその値を代入する。
+            // `std::vector<bool>::reference` と同じく、プロキシが指す先ではなく参照先の要素を書き換える。
+            constexpr const optional_vector_reference& operator=(const optional_vector_reference& rhs) const
+                noexcept(std::is_nothrow_copy_assignable_v<T>)
+                requires(!Const)
+            {
+                return *this = optional_vector_reference<T, true>{ rhs };
+            }
+
+            // 別の要素の有効値の有無と、有効値を保持していればその値を代入する。
+            constexpr const optional_vector_reference& operator=(optional_vector_reference<T, true> rhs) const
+                noexcept(std::is_nothrow_copy_assignable_v<T>)
+                requires(!Const)
+            {
+                if( rhs.has_value() )
+                {
+                    *m_value = *rhs;
+                    *m_word |= m_mask;
+                }
+                else
+                {
+                    *m_word &= ~m_mask;
+                }
+                return *this;
+            }
+
+            // 有効値を代入する。
+            template <class U = T>
+            requires (!Const && std::is_assignable_v<T&, U> && !std::same_as<std::remove_cvref_t<U>, std::nullopt_t>)
+            constexpr const optional_vector_reference& operator=(U&& v) const
+                noexcept(std::is_nothrow_assignable_v<T&, U>)
+            {
+                *m_value = std::forward<U>(v);
+                *m_word |= m_mask;
+                return *this;
+            }
+
+            // 無効値を保持していれば `true` を返す。
+            friend constexpr bool operator==(const optional_vector_reference& x, std::nullopt_t) noexcept
+            {
+                return !x.has_value();
+            }
+        };
+
+        // `optional_vector` の要素をプロキシとして返すランダムアクセスイテレータ。
+        template <class T, bool Const>
+        class optional_vector_iterator
+        {
+            using container = std::conditional_t<Const, const optional_vector<T>, optional_vector<T>>;
+
+            container* m_vec;
+            std::ptrdiff_t m_index;
+
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            // 要素を取り出して保持するときは値をコピーした `col::optional<T>` とし、コンテナの再確保後も有効にする。
+            using value_type = col::optional<T>;
+            using reference = optional_vector_reference<T, Const>;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr optional_vector_iterator() noexcept
+            : m_vec{ nullptr }
+            , m_index{ 0 }
+            {}
+
+            constexpr optional_vector_iterator(container* vec, std::ptrdiff_t index) noexcept
+            : m_vec{ vec }
+            , m_index{ index }
+            {}
+
+            constexpr operator optional_vector_iterator<T, true>() const noexcept
+                requires(!Const)
+            {
+                return optional_vector_iterator<T, true>{ m_vec, m_index };
+            }
+
+            constexpr reference operator*() const noexcept
+            {
+                return (*m_vec)[static_cast<std::size_t>(m_index)];
+            }
+            constexpr reference operator[](difference_type n) const noexcept
+            {
+                return (*m_vec)[static_cast<std::size_t>(m_index + n)];
+            }
+
+            constexpr optional_vector_iterator& operator++() noexcept
+            {
+                ++m_index;
+                return *this;
+            }
+            constexpr optional_vector_iterator operator++(int) noexcept
+            {
+                auto tmp = *this;
+                ++m_index;
+                return tmp;
+            }
+            constexpr optional_vector_iterator& operator--() noexcept
+            {
+                --m_index;
+                return *this;
+            }
+            constexpr optional_vector_iterator operator--(int) noexcept
+            {
+                auto tmp = *this;
+                --m_index;
+                return tmp;
+            }
+            constexpr optional_vector_iterator& operator+=(difference_type n) noexcept
+            {
+                m_index += n;
+                return *this;
+            }
+            constexpr optional_vector_iterator& operator-=(difference_type n) noexcept
+            {
+                m_index -= n;
+                return *this;
+            }
+
+            friend constexpr optional_vector_iterator operator+(optional_vector_iterator it, difference_type n) noexcept
+            {
+                return it += n;
+            }
+            friend constexpr optional_vector_iterator operator+(difference_type n, optional_vector_iterator it) noexcept
+            {
+                return it += n;
+            }
+            friend constexpr optional_vector_iterator operator-(optional_vector_iterator it, difference_type n) noexcept
+            {
+                return it -= n;
+            }
+            friend constexpr difference_type operator-(const optional_vector_iterator& x, const optional_vector_iterator& y) noexcept
+            {
+                return x.m_index - y.m_index;
+            }
+            friend constexpr bool operator==(const optional_vector_iterator& x, const optional_vector_iterator& y) noexcept
+            {
+                return x.m_index == y.m_index;
+            }
+            friend constexpr auto operator<=>(const optional_vector_iterator& x, const optional_vector_iterator& y) noexcept
+            {
+                return x.m_index <=> y.m_index;
+            }
+        };
+
+    } // namespace detail
+
+    // 省略可能な値の列を、値の列と有効値の有無を表すビット列とに分けて保持するコンテナ。
+    //
+    // `std::vector<col::optional<T, false>>` と異なり、有効値の有無のための領域とパディングは 1 要素あたり 1 ビットで済む。
+    // 値は連続した領域に並ぶため、 `values()` で列全体を走査できる。
+    // 無効値の要素の値の領域には、値初期化された `T` または以前に保持していた値が残る。
+    template <class T>
+    class optional_vector
+    {
+        static_assert(std::is_object_v<T> && !std::is_array_v<T>, "T must be a non-array object type");
+        static_assert(std::default_initializable<T> && std::copyable<T>);
+
+        using word_type = detail::optional_vector_word;
+        static constexpr std::size_t WordBits = detail::OptionalVectorWordBits;
+
+        template <class U>
+        friend class optional_vector;
+
+        std::vector<T> m_values;
+        // 有効値の有無。 `size()` 以降のビットは常に 0 。
+        std::vector<word_type> m_engaged;
+
+        static constexpr word_type bit_of(std::size_t i) noexcept
+        {
+            return word_type{ 1U } << (i % WordBits);
+        }
+
+        // `size()` 以降のビットを 0 にする。
+        constexpr void clear_tail() noexcept
+        {
+            if( const auto rest = m_values.size() % WordBits; rest != 0ZU )
+            {
+                m_engaged.back() &= (word_type{ 1U } << rest) - 1U;
+            }
+        }
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = detail::optional_vector_reference<T, false>;
+        using const_reference = detail::optional_vector_reference<T, true>;
+        using iterator = detail::optional_vector_iterator<T, false>;
+        using const_iterator = detail::optional_vector_iterator<T, true>;
+
+        /* コンストラクタ */
+
+        // 空の列を構築する。
+        constexpr optional_vector() noexcept
+        : m_values{}
+        , m_engaged{}
+        {}
+
+        // 無効値を `count` 個並べた列を構築する。
+        constexpr explicit optional_vector(size_type count)
+        : m_values(count)
+        , m_engaged(detail::optional_vector_words(count))
+        {}
+
+        // 省略可能な値のリストから構築する。
+        constexpr optional_vector(std::initializer_list<col::optional<T>> il)
+        : optional_vector()
+        {
+            reserve(il.size());
+            for( const auto& v : il )
+            {
+                if( v.has_value() )
+                {
+                    push_back(*v);
+                }
+                else
+                {
+                    push_back(std::nullopt);
+                }
+            }
+        }
+
+        /* 容量 */
+
+        constexpr size_type size() const noexcept
+        {
+            return m_values.size();
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return m_values.empty();
+        }
+
+        constexpr void reserve(size_type count)
+        {
+            m_values.reserve(count);
+            m_engaged.reserve(detail::optional_vector_words(count));
+        }
+
+        // 要素数を `count` にする。増えた要素は無効値になる。
+        constexpr void resize(size_type count)
+        {
+            m_values.resize(count);
+            m_engaged.resize(detail::optional_vector_words(count));
+            clear_tail();
+        }
+
+        constexpr void clear() noexcept
+        {
+            m_values.clear();
+            m_engaged.clear();
+        }
+
+        /* 要素の追加 */
+
+        // 有効値 `v` を末尾に追加する。
+        constexpr void push_back(const T& v)
+        {
+            emplace_back(v);
+        }
+
+        // 有効値 `v` を末尾に追加する。
+        constexpr void push_back(T&& v)
+        {
+            emplace_back(std::move(v));
+        }
+
+        // 無効値を末尾に追加する。
+        constexpr void push_back(std::nullopt_t)
+        {
+            if( m_values.size() % WordBits == 0ZU )
+            {
+                m_engaged.push_back(0U);
+            }
+            m_values.emplace_back();
+        }
+
+        // 型 `T` のコンストラクタ引数から有効値を構築して末尾に追加する。
+        template <class ...Args>
+        requires (std::is_constructible_v<T, Args...>)
+        constexpr T& emplace_back(Args&& ...args)
+        {
+            const auto i = m_values.size();
+            if( i % WordBits == 0ZU )
+            {
+                m_engaged.push_back(0U);
+            }
+            auto& v = m_values.emplace_back(std::forward<Args>(args)...);
+            m_engaged.back() |= bit_of(i);
+            return v;
+        }
+
+        /* 要素アクセス */
+
+        // `i` 番目の要素が有効値を保持しているか判定する。
+        constexpr bool has_value(size_type i) const noexcept
+        {
+            return (m_engaged[i / WordBits] & bit_of(i)) != 0U;
+        }
+
+        // `i` 番目の要素を参照するプロキシを返す。
+        constexpr reference operator[](size_type i) noexcept
+        {
+            return reference{ m_values.data() + i, m_engaged.data() + i / WordBits, bit_of(i) };
+        }
+
+        // `i` 番目の要素を参照するプロキシを返す。
+        constexpr const_reference operator[](size_type i) const noexcept
+        {
+            return const_reference{ m_values.data() + i, m_engaged.data() + i / WordBits, bit_of(i) };
+        }
+
+        // 値の列。無効値の要素の値も含む。
+        constexpr std::span<T> values() noexcept
+        {
+            return m_values;
+        }
+
+        // 値の列。無効値の要素の値も含む。
+        constexpr std::span<const T> values() const noexcept
+        {
+            return m_values;
+        }
+
+        // 有効値の有無を表すビット列。 `i` 番目の要素は `i / 64` 番目のワードの下位から `i % 64` 番目のビットに対応する。
+        constexpr std::span<const std::uint64_t> engaged_bits() const noexcept
+        {
+            return m_engaged;
+        }
+
+        constexpr iterator begin() noexcept
+        {
+            return iterator{ this, 0 };
+        }
+        constexpr const_iterator begin() const noexcept
+        {
+            return const_iterator{ this, 0 };
+        }
+        constexpr iterator end() noexcept
+        {
+            return iterator{ this, static_cast<std::ptrdiff_t>(size()) };
+        }
+        constexpr const_iterator end() const noexcept
+        {
+            return const_iterator{ this, static_cast<std::ptrdiff_t>(size()) };
+        }
+
+        /* 一括操作 */
+
+        // 有効値を保持している要素の個数を返す。
+        constexpr size_type count_engaged() const noexcept
+        {
+            size_type count = 0ZU;
+            for( const auto word : m_engaged )
+            {
+                count += static_cast<size_type>(std::popcount(word));
+            }
+            return count;
+        }
+
+        // すべての要素を無効値にする。値の領域はそのまま残る。
+        constexpr void fill_nullopt() noexcept
+        {
+            std::ranges::fill(m_engaged, word_type{ 0U });
+        }
+
+        // 有効値を保持している各要素に `f` を適用した結果を、同じ位置に格納した列を返す。
+        //
+        // 64 要素がすべて有効値であるブロックは、有効値の有無を調べない 1 つのループで変換する。
+        template <class F>
+        requires (std::invocable<F&, const T&>)
+        constexpr auto transform(F&& f) const
+        {
+            using U = std::remove_cvref_t<std::invoke_result_t<F&, const T&>>;
+            optional_vector<U> res{};
+            res.m_values.resize(size());
+            res.m_engaged = m_engaged;
+
+            const auto n = size();
+            for( size_type w = 0ZU; w < m_engaged.size(); ++w )
+            {
+                const auto word = m_engaged[w];
+                const auto first = w * WordBits;
+                const auto last = std::min(first + WordBits, n);
+                if( word == ~word_type{ 0U } )
+                {
+                    for( size_type i = first; i < last; ++i )
+                    {
+                        res.m_values[i] = std::invoke(f, m_values[i]);
+                    }
+                }
+                else
+                {
+                    for( auto bits = word; bits != 0U; bits &= bits - 1U )
+                    {
+                        const auto i = first + static_cast<size_type>(std::countr_zero(bits));
+                        res.m_values[i] = std::invoke(f, m_values[i]);
+                    }
+                }
+            }
+            return res;
+        }
+
+        // 有効値を保持している各要素に、 `col::optional` を返す `f` を適用した結果を、同じ位置に格納した列を返す。
+        // `f` が無効値を返した要素と、元から無効値だった要素は無効値になる。
+        template <class F>
+        requires (std::invocable<F&, const T&>)
+        constexpr auto and_then(F&& f) const
+        {
+            using R = std::remove_cvref_t<std::invoke_result_t<F&, const T&>>;
+            static_assert(
+                col::is_col_optional_v<R>,
+                "function's return type is not a specialized type of col::optional");
+            using U = std::remove_cvref_t<decltype(*std::declval<R&>())>;
+            optional_vector<U> res{};
+            res.m_values.resize(size());
+            res.m_engaged.resize(m_engaged.size());
+
+            for( size_type w = 0ZU; w < m_engaged.size(); ++w )
+            {
+                word_type out = 0U;
+                for( auto bits = m_engaged[w]; bits != 0U; bits &= bits - 1U )
+                {
+                    const auto bit = static_cast<size_type>(std::countr_zero(bits));
+                    const auto i = w * WordBits + bit;
+                    auto r = std::invoke(f, m_values[i]);
+                    if( r.has_value() )
+                    {
+                        res.m_values[i] = std::move(*r);
+                        out |= word_type{ 1U } << bit;
+                    }
+                }
+                res.m_engaged[w] = out;
+            }
+            return res;
+        }
+    };
+
+} // namespace col
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace col {
+
+    // オブジェクトのバイト列を別の領域へコピーし、元のオブジェクトを破棄せずに寿命を終えたものとみなしてよい型か調べる。
+    //
+    // トリビアルにコピー可能かつトリビアルに破棄可能な型は既定でこれを満たす。
+    // 自身のアドレスを保持しない所有権付きの型などは、この型を特殊化して `std::true_type` から派生することで指定できる。
+    template <class T>
+    struct is_trivially_relocatable : std::bool_constant<
+        std::is_trivially_copyable_v<T> &&
+        std::is_trivially_destructible_v<T>> {};
+
+    // `T` がトリビアルに再配置可能であれば `true` 、そうでなければ `false` 。
+    template <class T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+    // `[first, last)` のオブジェクトを未初期化の領域 `dest` へ再配置し、 `dest` 側の終端を返す。
+    // 呼び出し後、 `[first, last)` のオブジェクトは寿命を終えている。
+    //
+    // `T` がトリビアルに再配置可能であれば、実行時はムーブと破棄の代わりにバイト列を一括でコピーする。
+    // `[first, last)` と `dest` からの領域は重なっていてはならない。
+    template <class T>
+    requires (std::is_object_v<T> && std::is_move_constructible_v<T>)
+    constexpr T* uninitialized_relocate(T* first, T* last, T* dest)
+        noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+    {
+        if constexpr( is_trivially_relocatable_v<T> )
+        {
+            if !consteval
+            {
+                const auto count = static_cast<std::size_t>(last - first);
+                if( count != 0ZU )
+                {
+                    std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+                }
+                return dest + count;
+            }
+        }
+        for( ; first != last; ++first, ++dest )
+        {
+            std::construct_at(dest, std::move(*first));
+            std::destroy_at(first);
+        }
+        return dest;
+    }
+
+} // namespace col
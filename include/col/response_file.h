@@ -0,0 +1,494 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <array>
+#include <concepts>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace col {
+
+    // レスポンスファイルの入れ子の深さの上限。これより深い `@file` は展開せず、そのままの引数として扱う。
+    inline constexpr std::size_t MaxResponseFileDepth = 16ZU;
+
+    // レスポンスファイル中の引数の区切り方と引用符の解釈。
+    enum class ResponseFileQuoting : std::uint32_t
+    {
+        // GCC の `@file` と同じ。 `'` と `"` で囲んだ範囲は空白を含められ、 `\` は引用符の内外を問わず次の 1 文字をそのまま表す。
+        Gnu,
+        // MSVC の `@file` (コマンドライン解析規則) と同じ。 `"` のみが引用符であり、 `\` は `"` の直前にあるときだけ特別な意味を持つ。
+        Msvc,
+    };
+
+    // 書き込み可能なメモリに読み込んだファイル。
+    //
+    // POSIX 環境ではファイルを `MAP_PRIVATE` でメモリマップするため、書き込んでもファイルには反映されず、書き込んだページだけが複製される。
+    // それ以外の環境ではファイル全体をヒープに読み込む。
+    class MappedFile
+    {
+        char* m_data;
+        std::size_t m_size;
+        bool m_mapped;
+        std::unique_ptr<char[]> m_buffer;
+
+        MappedFile() noexcept
+        : m_data{ nullptr }
+        , m_size{ 0ZU }
+        , m_mapped{ false }
+        , m_buffer{}
+        {}
+
+    public:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+        : m_data{ std::exchange(other.m_data, nullptr) }
+        , m_size{ std::exchange(other.m_size, 0ZU) }
+        , m_mapped{ std::exchange(other.m_mapped, false) }
+        , m_buffer{ std::move(other.m_buffer) }
+        {}
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if( this != &other )
+            {
+                release();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0ZU);
+                m_mapped = std::exchange(other.m_mapped, false);
+                m_buffer = std::move(other.m_buffer);
+            }
+            return *this;
+        }
+
+        ~MappedFile()
+        {
+            release();
+        }
+
+        // `path` のファイルを開く。開けなかった場合は `std::nullopt` を返す。
+        [[nodiscard]] static std::optional<MappedFile> open(const char* path) noexcept
+        {
+            MappedFile file{};
+#if defined(__unix__) || defined(__APPLE__)
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if( fd < 0 )
+            {
+                return std::nullopt;
+            }
+            struct stat st{};
+            if( ::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) )
+            {
+                ::close(fd);
+                return std::nullopt;
+            }
+            file.m_size = static_cast<std::size_t>(st.st_size);
+            if( file.m_size > 0ZU )
+            {
+                void* p = ::mmap(nullptr, file.m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if( p == MAP_FAILED )
+                {
+                    ::close(fd);
+                    return std::nullopt;
+                }
+                file.m_data = static_cast<char*>(p);
+                file.m_mapped = true;
+            }
+            ::close(fd);
+#else
+            std::FILE* fp = std::fopen(path, "rb");
+            if( fp == nullptr )
+            {
+                return std::nullopt;
+            }
+            if( std::fseek(fp, 0, SEEK_END) != 0 )
+            {
+                std::fclose(fp);
+                return std::nullopt;
+            }
+            const long size = std::ftell(fp);
+            if( size < 0 || std::fseek(fp, 0, SEEK_SET) != 0 )
+            {
+                std::fclose(fp);
+                return std::nullopt;
+            }
+            file.m_size = static_cast<std::size_t>(size);
+            file.m_buffer = std::make_unique_for_overwrite<char[]>(file.m_size + 1ZU);
+            file.m_data = file.m_buffer.get();
+            if( std::fread(file.m_data, 1ZU, file.m_size, fp) != file.m_size )
+            {
+                std::fclose(fp);
+                return std::nullopt;
+            }
+            std::fclose(fp);
+#endif
+            return std::optional<MappedFile>{ std::move(file) };
+        }
+
+        // ファイルの内容の先頭。
+        [[nodiscard]] char* data() const noexcept
+        {
+            return m_data;
+        }
+
+        // ファイルの大きさ。
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        // 末尾の `size` 文字を、終端文字を付けて別に確保した領域へ複製する。
+        // メモリマップした領域には終端文字を書き込む余地がないため、ファイル末尾で終わる引数に用いる。
+        // 同じファイルに対して高々 1 度だけ呼び出される。
+        [[nodiscard]] const char* copy_tail(std::size_t size) noexcept
+        {
+            if( !m_mapped )
+            {
+                // ヒープに読み込んだ場合は末尾に 1 文字分の余地がある
+                m_data[m_size] = '\0';
+                return m_data + (m_size - size);
+            }
+            m_buffer = std::make_unique_for_overwrite<char[]>(size + 1ZU);
+            std::memcpy(m_buffer.get(), m_data + (m_size - size), size);
+            m_buffer[size] = '\0';
+            return m_buffer.get();
+        }
+
+    private:
+        void release() noexcept
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if( m_mapped )
+            {
+                ::munmap(m_data, m_size);
+            }
+#endif
+            m_data = nullptr;
+            m_size = 0ZU;
+            m_mapped = false;
+        }
+    };
+
+    namespace detail {
+
+        // レスポンスファイル中の空白文字。
+        constexpr bool is_response_file_space(char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        // `[first, last)` の先頭から引数を 1 つ切り出し、引用符とエスケープを解いた結果を `first` から書き込む。
+        // 書き込み終えた位置と、引数の直後の読み込み位置を返す。
+        //
+        // 書き込み位置が読み込み位置を追い越すことはないため、ファイルの内容をその場で書き換えられる。
+        constexpr std::pair<char*, char*> unquote_gnu(char* first, char* last) noexcept
+        {
+            char* out = first;
+            char* in = first;
+            char quote = '\0';
+            for( ; in != last; ++in )
+            {
+                const char c = *in;
+                if( c == '\\' && in + 1 != last )
+                {
+                    ++in;
+                    *out++ = *in;
+                }
+                else if( quote != '\0' )
+                {
+                    if( c == quote )
+                    {
+                        quote = '\0';
+                    }
+                    else
+                    {
+                        *out++ = c;
+                    }
+                }
+                else if( c == '\'' || c == '"' )
+                {
+                    quote = c;
+                }
+                else if( is_response_file_space(c) )
+                {
+                    break;
+                }
+                else
+                {
+                    *out++ = c;
+                }
+            }
+            return { out, in };
+        }
+
+        // `unquote_gnu` の MSVC 版。
+        //
+        // `2n` 個の `\` に続く `"` は `n` 個の `\` となり、引用の開始・終了を表す。
+        // `2n + 1` 個の `\` に続く `"` は `n` 個の `\` と `"` そのものになる。
+        // 引用中の `""` は `"` そのものになり、引用は続く。
+        constexpr std::pair<char*, char*> unquote_msvc(char* first, char* last) noexcept
+        {
+            char* out = first;
+            char* in = first;
+            bool quoted = false;
+            while( in != last )
+            {
+                const char c = *in;
+                if( c == '\\' )
+                {
+                    std::size_t backslashes = 0ZU;
+                    for( ; in != last && *in == '\\'; ++in )
+                    {
+                        ++backslashes;
+                    }
+                    if( in != last && *in == '"' )
+                    {
+                        for( std::size_t i = 0ZU; i < backslashes / 2ZU; ++i )
+                        {
+                            *out++ = '\\';
+                        }
+                        if( backslashes % 2ZU == 1ZU )
+                        {
+                            *out++ = '"';
+                            ++in;
+                        }
+                    }
+                    else
+                    {
+                        for( std::size_t i = 0ZU; i < backslashes; ++i )
+                        {
+                            *out++ = '\\';
+                        }
+                    }
+                }
+                else if( c == '"' )
+                {
+                    ++in;
+                    if( quoted && in != last && *in == '"' )
+                    {
+                        *out++ = '"';
+                        ++in;
+                    }
+                    else
+                    {
+                        quoted = !quoted;
+                    }
+                }
+                else if( !quoted && is_response_file_space(c) )
+                {
+                    break;
+                }
+                else
+                {
+                    *out++ = c;
+                    ++in;
+                }
+            }
+            return { out, in };
+        }
+
+    } // namespace detail
+
+    // コマンドライン引数の列 `[first, last)` のうち、 `@path` を `path` のファイルに書かれた引数の列に置き換えて列挙する入力範囲。
+    //
+    // レスポンスファイルはメモリマップされ、引数は列挙するたびにマップした領域の中で区切られる。
+    // 各引数は領域の中をそのまま指す終端文字付きの文字列であり、引数ごとのメモリ確保は行わない。
+    // ファイルの末尾で終わる引数だけは、終端文字を付けるためにファイルごとに 1 度だけ複製される。
+    //
+    // レスポンスファイル中の `@path` も展開する。開けないファイルや、入れ子が `MaxResponseFileDepth` を超える `@path` は GCC と同じくそのまま引数として扱う。
+    //
+    // 列挙した引数はこのオブジェクトが破棄されるまで有効である。
+    // `begin()` が返すイテレータを `col::Cmd::parse(I& iter, const S& sentinel)` にそのまま渡せる。
+    template <std::input_iterator I, std::sentinel_for<I> S>
+    requires (std::convertible_to<std::iter_reference_t<I>, const char*>)
+    class ResponseFileArgs
+    {
+        // 展開中のレスポンスファイルの未読の範囲。
+        struct Frame
+        {
+            std::size_t file;
+            char* cur;
+            char* last;
+        };
+
+        I m_iter;
+        S m_sentinel;
+        ResponseFileQuoting m_quoting;
+        bool m_started;
+        const char* m_current;
+        std::vector<MappedFile> m_files;
+        std::array<Frame, MaxResponseFileDepth> m_frames;
+        std::size_t m_depth;
+
+    public:
+        // `ResponseFileArgs` を走査する入力イテレータ。
+        class iterator
+        {
+            ResponseFileArgs* m_args;
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = const char*;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() noexcept
+            : m_args{ nullptr }
+            {}
+
+            explicit iterator(ResponseFileArgs& args) noexcept
+            : m_args{ &args }
+            {}
+
+            const char* operator*() const noexcept
+            {
+                return m_args->m_current;
+            }
+
+            iterator& operator++()
+            {
+                m_args->advance();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                m_args->advance();
+            }
+
+            friend bool operator==(const iterator& iter, std::default_sentinel_t) noexcept
+            {
+                return iter.m_args == nullptr || *iter == nullptr;
+            }
+        };
+
+        ResponseFileArgs(I first, S last, ResponseFileQuoting quoting = ResponseFileQuoting::Gnu)
+        : m_iter{ std::move(first) }
+        , m_sentinel{ std::move(last) }
+        , m_quoting{ quoting }
+        , m_started{ false }
+        , m_current{ nullptr }
+        , m_files{}
+        , m_frames{}
+        , m_depth{ 0ZU }
+        {}
+
+        ResponseFileArgs(const ResponseFileArgs&) = delete;
+        ResponseFileArgs& operator=(const ResponseFileArgs&) = delete;
+
+        // 先頭の引数を指すイテレータを得る。入力範囲であるため、 2 度目以降の呼び出しでは現在の位置を指す。
+        [[nodiscard]] iterator begin()
+        {
+            if( !m_started )
+            {
+                m_started = true;
+                advance();
+            }
+            return iterator{ *this };
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        // 次の引数へ進む。
+        void advance()
+        {
+            while( true )
+            {
+                const char* arg = nullptr;
+                if( m_depth > 0ZU )
+                {
+                    arg = next_in_file(m_frames[m_depth - 1ZU]);
+                    if( arg == nullptr )
+                    {
+                        --m_depth;
+                        continue;
+                    }
+                }
+                else if( m_iter != m_sentinel )
+                {
+                    arg = *m_iter;
+                    ++m_iter;
+                }
+                else
+                {
+                    m_current = nullptr;
+                    return;
+                }
+
+                if( arg[0] == '@' && arg[1] != '\0' && m_depth < MaxResponseFileDepth )
+                {
+                    if( auto file = MappedFile::open(arg + 1) )
+                    {
+                        auto& mapped = m_files.emplace_back(std::move(*file));
+                        m_frames[m_depth] = Frame{
+                            .file = m_files.size() - 1ZU,
+                            .cur = mapped.data(),
+                            .last = mapped.data() + mapped.size(),
+                        };
+                        ++m_depth;
+                        continue;
+                    }
+                }
+                m_current = arg;
+                return;
+            }
+        }
+
+        // `frame` から次の引数を切り出す。残りが空白だけであれば `nullptr` を返す。
+        const char* next_in_file(Frame& frame) noexcept
+        {
+            while( frame.cur != frame.last && detail::is_response_file_space(*frame.cur) )
+            {
+                ++frame.cur;
+            }
+            if( frame.cur == frame.last )
+            {
+                return nullptr;
+            }
+
+            char* const first = frame.cur;
+            const auto [out, in] = m_quoting == ResponseFileQuoting::Gnu
+                ? detail::unquote_gnu(first, frame.last)
+                : detail::unquote_msvc(first, frame.last);
+            if( in != frame.last )
+            {
+                // `*in` は区切りの空白であり、終端文字で上書きしてよい
+                *out = '\0';
+                frame.cur = in + 1;
+                return first;
+            }
+            frame.cur = frame.last;
+            if( out != frame.last )
+            {
+                *out = '\0';
+                return first;
+            }
+            return m_files[frame.file].copy_tail(static_cast<std::size_t>(out - first));
+        }
+    };
+
+    // 推論補助
+    template <class I, class S>
+    ResponseFileArgs(I, S) -> ResponseFileArgs<I, S>;
+    // 推論補助
+    template <class I, class S>
+    ResponseFileArgs(I, S, ResponseFileQuoting) -> ResponseFileArgs<I, S>;
+
+} // namespace col
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <cstddef>
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace col {
+
+    // 値 `T` を返すコルーチンの型。
+    //
+    // `co_await` されるまで開始せず、完了すると `co_await` したコルーチンを再開する。
+    // 例外を用いないため `-fno-exceptions` でも使用でき、コルーチン内で送出された例外は `std::terminate` で終了する。
+    // 1 つのタスクを `co_await` できるのは 1 度だけ。
+    template <class T>
+    class [[nodiscard]] Task
+    {
+        static_assert(std::is_object_v<T> && !std::is_array_v<T>);
+    public:
+        class promise_type
+        {
+            friend class Task;
+
+            std::optional<T> m_value;
+            std::coroutine_handle<> m_continuation;
+
+            // 完了時に `co_await` していたコルーチンへ制御を移す。
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+                {
+                    const auto continuation = h.promise().m_continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+                void await_resume() const noexcept
+                {}
+            };
+        public:
+            promise_type() noexcept
+            : m_value{}
+            , m_continuation{}
+            {}
+
+            Task get_return_object() noexcept
+            {
+                return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+            template <class U = T>
+            requires (std::is_constructible_v<T, U>)
+            void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U>)
+            {
+                m_value.emplace(std::forward<U>(value));
+            }
+            [[noreturn]] void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+        : m_handle{ handle }
+        {}
+
+        // `co_await` したコルーチンを継続として登録し、このタスクを開始する。
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) const noexcept
+            {
+                handle.promise().m_continuation = continuation;
+                return handle;
+            }
+            T await_resume() const noexcept(std::is_nothrow_move_constructible_v<T>)
+            {
+                return std::move(*handle.promise().m_value);
+            }
+        };
+    public:
+        // 結果の型。
+        using value_type = T;
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept
+        : m_handle{ std::exchange(other.m_handle, nullptr) }
+        {}
+        Task& operator=(Task&& other) noexcept
+        {
+            if( this != &other )
+            {
+                if( m_handle )
+                {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~Task()
+        {
+            if( m_handle )
+            {
+                m_handle.destroy();
+            }
+        }
+
+        Awaiter operator co_await() const& noexcept
+        {
+            return Awaiter{ m_handle };
+        }
+        Awaiter operator co_await() const&& noexcept
+        {
+            return Awaiter{ m_handle };
+        }
+    };
+
+    // `T` が `col::Task` か判定する。
+    template <class T>
+    struct is_col_task : std::false_type {};
+    // `T` が `col::Task` か判定する。
+    template <class T>
+    struct is_col_task<Task<T>> : std::true_type {};
+    // `T` が `col::Task` であれば `true` 、でなければ `false` 。
+    template <class T>
+    inline constexpr bool is_col_task_v = is_col_task<std::remove_cvref_t<T>>::value;
+
+    // `T` が `col::Task` であればその結果の型、そうでなければ `T` をメンバ型 `type` に持つ。
+    template <class T>
+    struct unwrap_task_type_if
+    {
+        using type = T;
+    };
+    // `T` が `col::Task` であればその結果の型、そうでなければ `T` をメンバ型 `type` に持つ。
+    template <class T>
+    requires (is_col_task_v<T>)
+    struct unwrap_task_type_if<T>
+    {
+        using type = std::remove_cvref_t<T>::value_type;
+    };
+    // `T` が `col::Task` であればその結果の型、そうでなければ `T` 。
+    template <class T>
+    using unwrap_task_type_if_t = unwrap_task_type_if<T>::type;
+
+    // 値 `value` をそのまま結果とするタスクを生成する。
+    template <class T>
+    Task<std::remove_cvref_t<T>> ready_task(T value)
+    {
+        co_return std::move(value);
+    }
+
+    namespace detail {
+
+        // `when_all` が子タスクの完了を数えるためのカウンタ。
+        // 最後に完了した子タスク、または子タスクをすべて開始し終えた親が `continuation` を再開する。
+        struct WhenAllLatch
+        {
+            std::atomic<std::size_t> count;
+            std::coroutine_handle<> continuation;
+        };
+
+        // `when_all` がタスク 1 つを `co_await` するためのコルーチンの型。
+        class WhenAllChild
+        {
+        public:
+            class promise_type
+            {
+                friend class WhenAllChild;
+
+                WhenAllLatch* m_latch;
+
+                struct FinalAwaiter
+                {
+                    bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+                    {
+                        WhenAllLatch& latch = *h.promise().m_latch;
+                        if( latch.count.fetch_sub(1ZU, std::memory_order_acq_rel) == 1ZU )
+                        {
+                            return latch.continuation;
+                        }
+                        return std::noop_coroutine();
+                    }
+                    void await_resume() const noexcept
+                    {}
+                };
+            public:
+                promise_type() noexcept
+                : m_latch{ nullptr }
+                {}
+
+                WhenAllChild get_return_object() noexcept
+                {
+                    return WhenAllChild{ std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+                std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+                FinalAwaiter final_suspend() const noexcept
+                {
+                    return {};
+                }
+                void return_void() const noexcept
+                {}
+                [[noreturn]] void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+            };
+
+        private:
+            std::coroutine_handle<promise_type> m_handle;
+
+            explicit WhenAllChild(std::coroutine_handle<promise_type> handle) noexcept
+            : m_handle{ handle }
+            {}
+        public:
+            WhenAllChild(const WhenAllChild&) = delete;
+            WhenAllChild& operator=(const WhenAllChild&) = delete;
+            WhenAllChild(WhenAllChild&& other) noexcept
+            : m_handle{ std::exchange(other.m_handle, nullptr) }
+            {}
+            WhenAllChild& operator=(WhenAllChild&&) = delete;
+
+            ~WhenAllChild()
+            {
+                if( m_handle )
+                {
+                    m_handle.destroy();
+                }
+            }
+
+            // `latch` に完了を通知するようにして開始する。
+            void start(WhenAllLatch& latch) const noexcept
+            {
+                m_handle.promise().m_latch = &latch;
+                m_handle.resume();
+            }
+        };
+
+        // `task` を `co_await` し、その結果を `out` に格納する。
+        template <class T>
+        WhenAllChild when_all_child(Task<T>& task, std::optional<T>& out)
+        {
+            out.emplace(co_await task);
+        }
+
+        // 子タスクをすべて開始し、すべて完了するまで `co_await` したコルーチンを中断する。
+        struct WhenAllAwaiter
+        {
+            std::vector<WhenAllChild>& children;
+            WhenAllLatch latch;
+
+            bool await_ready() const noexcept
+            {
+                return children.empty();
+            }
+            bool await_suspend(std::coroutine_handle<> continuation) noexcept
+            {
+                latch.continuation = continuation;
+                for( const auto& child : children )
+                {
+                    child.start(latch);
+                }
+                // 子タスクがすべて同期的に完了していれば、中断せずにそのまま続ける
+                return latch.count.fetch_sub(1ZU, std::memory_order_acq_rel) != 1ZU;
+            }
+            void await_resume() const noexcept
+            {}
+        };
+
+    } // namespace detail
+
+    // タスクの列 `tasks` をすべて開始してから完了を待ち、その結果を同じ順に並べて返すタスクを生成する。
+    //
+    // 各タスクは、先のタスクが中断した時点で次のタスクが開始されるため、待ち時間のあるタスクどうしは並行して進む。
+    // どのタスクを再開したスレッドで最後のタスクが完了しても、そのスレッドで `co_await` したコルーチンが再開される。
+    template <class T>
+    Task<std::vector<T>> when_all(std::vector<Task<T>> tasks)
+    {
+        std::vector<std::optional<T>> results(tasks.size());
+        std::vector<detail::WhenAllChild> children{};
+        children.reserve(tasks.size());
+        for( std::size_t i = 0ZU; i < tasks.size(); ++i )
+        {
+            children.push_back(detail::when_all_child(tasks[i], results[i]));
+        }
+        co_await detail::WhenAllAwaiter{
+            .children = children,
+            .latch = { children.size() + 1ZU, nullptr },
+        };
+
+        std::vector<T> values{};
+        values.reserve(results.size());
+        for( auto& result : results )
+        {
+            values.push_back(std::move(*result));
+        }
+        co_return values;
+    }
+
+    // タスク `task` を開始し、完了するまで呼び出したスレッドをブロックしてその結果を返す。
+    template <class T>
+    T sync_wait(Task<T> task)
+    {
+        std::mutex mutex{};
+        std::condition_variable cv{};
+        bool done = false;
+        std::optional<T> result{};
+
+        struct Waiter
+        {
+            class promise_type
+            {
+            public:
+                Waiter get_return_object() noexcept
+                {
+                    return Waiter{ std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+                std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+                // 完了を通知した後は待機側がフレームに触れないよう、完了したスレッドでフレームを破棄する
+                std::suspend_never final_suspend() const noexcept
+                {
+                    return {};
+                }
+                void return_void() const noexcept
+                {}
+                [[noreturn]] void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+            };
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        // 完了の通知はロックを保持したまま行い、待機側がこのスタックフレームを破棄する前に通知を終える。
+        // 通知の後も完了したスレッドはコルーチンのフレームを最終中断点まで進めるため、待機側はフレームを破棄しない
+        const auto waiter = [](Task<T>& t, std::optional<T>& out, std::mutex& m, std::condition_variable& c, bool& d) -> Waiter
+            {
+                out.emplace(co_await t);
+                const std::lock_guard lock{ m };
+                d = true;
+                c.notify_one();
+            }(task, result, mutex, cv, done);
+        waiter.handle.resume();
+        {
+            std::unique_lock lock{ mutex };
+            cv.wait(lock, [&done]() noexcept { return done; });
+        }
+        return std::move(*result);
+    }
+
+} // namespace col
@@ -4,7 +4,9 @@
 #include <col/type_traits.h>
 
 #include <cstddef>
+#include <array>
 #include <functional>
+#include <optional>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -182,29 +184,6 @@ namespace col {
         }(tuple, filter_index_sequence<make_tuple_applyer<Tuple, Trait>::template apply>(std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<Tuple>>>()));
     }
 
-    namespace detail {
-        template <class T, class F, std::size_t Index, std::size_t ...Idx>
-        requires (is_visitor_for_v<F, T> && ( std::tuple_size_v<std::remove_cvref_t<T>> > 0 || requires {
-            is_control_flow_v<std::remove_cvref_t<std::invoke_result_t<F, std::tuple_element_t<0, T>>>>;  
-        }))
-        constexpr auto tuple_try_foreach_impl(T&& t, F& f)
-        {
-            if constexpr( sizeof...(Idx) > 0 )
-            {
-                const auto res = std::invoke(f, std::get<Index>(t));
-                if( res.is_break() )
-                {
-                    return std::move(res);
-                }
-                return tuple_try_foreach_impl<T, F, Idx...>(t, f);
-            }
-            else
-            {
-                return std::invoke(f, std::get<Index>(t));
-            }
-        }
-    } // namespace detail
-
     template <class F, class T>
     requires (is_visitor_for_v<F, T>)
     constexpr void tuple_foreach(F&& f, T&& t)
@@ -217,17 +196,89 @@ namespace col {
             }, std::forward<T>(t));
     }
 
+    // tuple-like な `t` の各要素に先頭から順に `f` を呼び出し、 `ControlFlow` が `Break` を返した時点で打ち切る。
+    // 最初の `Break` か、すべて `Continue` であれば最後の要素に対する結果を返す。
+    //
+    // 再帰せず、 `&&` の畳み込み式で短絡評価するため、要素数によらずテンプレートの実体化の深さは一定となる。
+    // `f` は各要素に対して同じ `ControlFlow` 型を返さなければならない。
     template <class F, class T>
-    requires (is_visitor_for_v<F, T>)
+    requires (
+        is_visitor_for_v<F, T> &&
+        std::tuple_size_v<std::remove_cvref_t<T>> > 0 &&
+        is_control_flow_v<std::remove_cvref_t<std::invoke_result_t<F&, decltype(std::get<0>(std::declval<std::remove_reference_t<T>&>()))>>>
+    )
     constexpr auto tuple_try_foreach(F&& f, T&& t)
     {
-        auto&& fn = std::forward<F>(f);
-        return [&]<std::size_t ...Idx>(std::index_sequence<Idx...>)
+        using R = std::remove_cvref_t<std::invoke_result_t<F&, decltype(std::get<0>(std::declval<std::remove_reference_t<T>&>()))>>;
+        return [&]<std::size_t ...Idx>(std::index_sequence<Idx...>) -> R
+        {
+            std::optional<R> res{};
+            static_cast<void>((
+                (static_cast<void>(res.emplace(std::invoke(f, std::get<Idx>(t)))), res->is_continue()) && ...
+            ));
+            return std::move(*res);
+        }(std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<T>>>{});
+    }
+
+    namespace detail {
+        template <std::size_t Index, class R, class F, class T>
+        constexpr R tuple_visit_at_impl(F& f, T& t)
+        {
+            return std::invoke(f, std::get<Index>(t));
+        }
+    } // namespace detail
+
+    // tuple-like な `t` の `index` 番目の要素に対して `f` を呼び出し、その結果を返す。
+    // 呼び出しはインデックスで引くジャンプテーブルで分岐するため、要素数によらず O(1) で対象の要素に到達する。
+    //
+    // `f` は各要素に対して同じ型を返さなければならない。 `index` は要素数未満でなければならない。
+    template <class F, class T>
+    requires (
+        is_visitor_for_v<F, T> &&
+        std::tuple_size_v<std::remove_cvref_t<T>> > 0
+    )
+    constexpr decltype(auto) tuple_visit_at(std::size_t index, F&& f, T&& t)
+    {
+        using Fn = std::remove_reference_t<F>;
+        using Tuple = std::remove_reference_t<T>;
+        using R = std::invoke_result_t<Fn&, decltype(std::get<0>(std::declval<Tuple&>()))>;
+        return [&]<std::size_t ...Idx>(std::index_sequence<Idx...>) -> R
         {
-            return detail::tuple_try_foreach_impl<T, F, Idx...>(t, fn);
+            constexpr std::array<R (*)(Fn&, Tuple&), sizeof...(Idx)> table{
+                &detail::tuple_visit_at_impl<Idx, R, Fn, Tuple>...
+            };
+            return table[index](f, t);
         }(std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<T>>>{});
     }
 
+    namespace detail {
+        template <std::size_t Index, class R, class F>
+        constexpr R visit_index_impl(F& f)
+        {
+            return std::invoke(f, std::integral_constant<std::size_t, Index>{});
+        }
+    } // namespace detail
+
+    // `index` を `std::integral_constant<std::size_t, index>` として `f` を呼び出し、その結果を返す。
+    // `tuple_visit_at` と同じくジャンプテーブルで分岐するため、 `N` によらず O(1) で呼び出し先に到達する。
+    // 複数の tuple の同じ位置の要素を、 tuple をまとめ直さずに参照するときに使う。
+    //
+    // `f` は各インデックスに対して同じ型を返さなければならない。 `index` は `N` 未満でなければならない。
+    template <std::size_t N, class F>
+    requires (N > 0ZU)
+    constexpr decltype(auto) visit_index(std::size_t index, F&& f)
+    {
+        using Fn = std::remove_reference_t<F>;
+        using R = std::invoke_result_t<Fn&, std::integral_constant<std::size_t, 0ZU>>;
+        return [&]<std::size_t ...Idx>(std::index_sequence<Idx...>) -> R
+        {
+            constexpr std::array<R (*)(Fn&), sizeof...(Idx)> table{
+                &detail::visit_index_impl<Idx, R, Fn>...
+            };
+            return table[index](f);
+        }(std::make_index_sequence<N>{});
+    }
+
     inline void tuple_foreach_static_test() {
         constexpr auto res = []()
             {
@@ -256,6 +307,51 @@ namespace col {
         }, t);
         static_assert(res.is_continue() == false);
         static_assert(res == Break{-1});
+
+        // 最初の Break で打ち切られ、以降の要素には呼び出されない
+        constexpr auto visited = []()
+            {
+                constexpr std::tuple<int, int, int, int> t4{ 1, 2, 3, 4 };
+                int count = 0;
+                const auto r = tuple_try_foreach([&count](int e) -> ControlFlow<int>
+                    {
+                        ++count;
+                        if( e == 2 )
+                        {
+                            return Break{e};
+                        }
+                        return Continue{};
+                    }, t4);
+                return std::pair{ r.to_break(), count };
+            }();
+        static_assert(visited.first == 2);
+        static_assert(visited.second == 2);
+    }
+
+    inline void tuple_visit_at_static_test() {
+        static constexpr std::tuple<int, long, short> t{ 1, 20L, 300 };
+        constexpr auto visit = [](std::size_t index)
+        {
+            return tuple_visit_at(index, []<class T>(const T& e) -> long { return static_cast<long>(e); }, t);
+        };
+        static_assert(visit(0) == 1L);
+        static_assert(visit(1) == 20L);
+        static_assert(visit(2) == 300L);
+    }
+
+    inline void visit_index_static_test() {
+        static constexpr std::tuple<int, long, short> t{ 1, 20L, 300 };
+        static constexpr std::tuple<long, int, int> u{ 4L, 50, 600 };
+        constexpr auto visit = [](std::size_t index)
+        {
+            return visit_index<3ZU>(index, []<std::size_t I>(std::integral_constant<std::size_t, I>) -> long
+                {
+                    return static_cast<long>(std::get<I>(t)) + static_cast<long>(std::get<I>(u));
+                });
+        };
+        static_assert(visit(0) == 5L);
+        static_assert(visit(1) == 70L);
+        static_assert(visit(2) == 900L);
     }
 
     namespace detail {
@@ -0,0 +1,147 @@
+#include <col/command.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include <array>
+#include <format>
+#include <new>
+#include <string_view>
+#include <variant>
+
+
+namespace {
+
+    // グローバルな `operator new` が呼び出された回数。
+    constinit std::size_t allocation_count = 0ZU;
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    if( void* p = std::malloc(size == 0ZU ? 1ZU : size) )
+    {
+        return p;
+    }
+    std::abort();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+    struct SubSubCmd
+    {
+        int num;
+    };
+    struct SubCmd
+    {
+        std::variant<std::monostate, SubSubCmd> subsub;
+        bool flag;
+        long value;
+    };
+    struct Cmd
+    {
+        std::variant<std::monostate, SubCmd> sub;
+        bool verbose;
+        unsigned int count;
+    };
+
+    constexpr auto parser = col::Cmd{"cmd", "allocation test"}
+        .add(col::Arg{"verbose", "verbose"})
+        .add(col::Arg<unsigned int>{"count", "count"})
+        .add(col::SubCmd<SubCmd>{"sub", "subcommand"}
+            .add(col::Arg{"flag", "flag"})
+            .add(col::Arg<long>{"value", "value"})
+            .add(col::SubCmd<SubSubCmd>{"subsub", "subsubcommand"}
+                .add(col::Arg{"num", "num"}.set_default_value(1))));
+
+    // `args` のパース中に `operator new` が呼び出された回数を返す。
+    template <std::size_t N>
+    std::size_t count_allocations(const std::array<const char*, N>& args, bool expect_success)
+    {
+        allocation_count = 0ZU;
+        const auto res = parser.parse<Cmd>(args);
+        const auto count = allocation_count;
+        if( res.has_value() != expect_success )
+        {
+            std::fputs("unexpected parse result\n", stderr);
+            std::exit(EXIT_FAILURE);
+        }
+        return count;
+    }
+
+    bool expect_no_allocation(const char* name, std::size_t count)
+    {
+        if( count != 0ZU )
+        {
+            std::fprintf(stderr, "%s: %zu allocation(s) during parse\n", name, count);
+            return false;
+        }
+        return true;
+    }
+
+    // `args` のパースが `UnknownOption` で失敗し、書式化した文字列が `expected` と一致するかを調べる。
+    // パース中にアロケーションが行われないことも調べる。
+    template <std::size_t N>
+    bool expect_unknown_option(const char* name, const std::array<const char*, N>& args, std::string_view expected)
+    {
+        allocation_count = 0ZU;
+        const auto res = parser.parse<Cmd>(args);
+        const auto count = allocation_count;
+        if( res.has_value() || res.error().kind() != col::ParseErrorKind::UnknownOption )
+        {
+            std::fprintf(stderr, "%s: unexpected parse result\n", name);
+            return false;
+        }
+        const auto message = std::format("{}", parser.explain(res.error()));
+        if( message != expected )
+        {
+            std::fprintf(stderr, "%s: unexpected message: %s\n", name, message.c_str());
+            return false;
+        }
+        return expect_no_allocation(name, count);
+    }
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+
+    // 成功するパースはアロケーションを行わない
+    ok &= expect_no_allocation("options",
+        count_allocations(std::array{ "--verbose", "--count", "42" }, true));
+    ok &= expect_no_allocation("nested subcommands",
+        count_allocations(std::array{ "--count", "1", "sub", "--value", "-7", "subsub", "--num", "3" }, true));
+    ok &= expect_no_allocation("defaults",
+        count_allocations(std::array<const char*, 0>{}, true));
+
+    // `--help` はヘルプメッセージを書式化するまでアロケーションを行わない
+    ok &= expect_no_allocation("help",
+        count_allocations(std::array{ "sub", "subsub", "--help" }, false));
+
+    // 不明なオプションは書式化するまで綴りの近い名前を探さず、アロケーションも行わない
+    ok &= expect_unknown_option("typo", std::array{ "--verbsoe" },
+        "unknown option: arg='--verbsoe' (did you mean '--verbose'?)");
+    ok &= expect_unknown_option("typo with value", std::array{ "--cuont=3" },
+        "unknown option: arg='--cuont=3' (did you mean '--count'?)");
+    ok &= expect_unknown_option("subcommand", std::array{ "--sub" },
+        "unknown option: arg='--sub' (did you mean 'sub'?)");
+    ok &= expect_unknown_option("nested", std::array{ "sub", "--flg" },
+        "unknown option: arg='--flg' (did you mean '--flag'?)");
+    ok &= expect_unknown_option("no suggestion", std::array{ "--xyz" },
+        "unknown option: arg='--xyz'");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
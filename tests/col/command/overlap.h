@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace col::test {
+
+    // 同時に実行された処理の数を数え、指定した数の処理が重なるまで待てるようにする。
+    // 経過時間に頼らずに、処理が同時に実行されたかを `max_running()` で確かめられるようにする。
+    class OverlapCounter
+    {
+        // 重なるのを待つ時間の上限。処理が同時に実行されなければ、これだけ待ってから進む。
+        static constexpr auto Timeout = std::chrono::seconds{ 5 };
+
+        // 同時に実行されるまで待つ処理の数。
+        std::atomic<std::size_t> m_required{ 1ZU };
+        // 開始した処理の数。
+        std::atomic<std::size_t> m_started{ 0ZU };
+        // 実行中の処理の数と、その最大値。
+        std::atomic<std::size_t> m_running{ 0ZU };
+        std::atomic<std::size_t> m_max_running{ 0ZU };
+
+    public:
+        // カウンタを初期化し、 `required` 個の処理が同時に実行されるまで待つようにする。
+        void reset(std::size_t required) noexcept
+        {
+            m_required = required;
+            m_started = 0ZU;
+            m_running = 0ZU;
+            m_max_running = 0ZU;
+        }
+
+        // 処理の開始を記録する。
+        void enter() noexcept
+        {
+            ++m_started;
+            const auto running = ++m_running;
+            auto max = m_max_running.load();
+            while( max < running && !m_max_running.compare_exchange_weak(max, running) )
+            {}
+        }
+
+        // 処理の終了を記録する。
+        void leave() noexcept
+        {
+            --m_running;
+        }
+
+        // 指定した数の処理が同時に実行されるまで、上限まで待つ。
+        void wait() const
+        {
+            const auto deadline = std::chrono::steady_clock::now() + Timeout;
+            while( m_max_running.load() < m_required.load() && std::chrono::steady_clock::now() < deadline )
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+            }
+        }
+
+        [[nodiscard]] std::size_t started() const noexcept
+        {
+            return m_started.load();
+        }
+
+        [[nodiscard]] std::size_t max_running() const noexcept
+        {
+            return m_max_running.load();
+        }
+    };
+
+} // namespace col::test
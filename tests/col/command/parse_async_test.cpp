@@ -0,0 +1,200 @@
+#include "overlap.h"
+
+#include <col/command.h>
+#include <col/task.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include <array>
+#include <coroutine>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+namespace {
+
+    // 同時に実行されたパーサーを数える。
+    col::test::OverlapCounter parsers{};
+
+    // 別のスレッドで、指定した数のパーサーが同時に実行されるまで待ってから、 `co_await` したコルーチンを再開する。
+    struct WaitForOverlap
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> h) const
+        {
+            std::thread{ [h]()
+                {
+                    parsers.wait();
+                    h.resume();
+                } }.detach();
+        }
+        void await_resume() const noexcept
+        {}
+    };
+
+    // 他のパーサーと同時に実行されるのを待ってから、 `"ok"` で始まる文字列だけを受け付ける。
+    constexpr auto slow_parser = [](const char* str) -> col::Task<std::optional<std::string_view>>
+        {
+            parsers.enter();
+            co_await WaitForOverlap{};
+            parsers.leave();
+            const std::string_view s{ str };
+            if( s.starts_with("ok") )
+            {
+                co_return s;
+            }
+            co_return std::nullopt;
+        };
+
+    struct SubCmd
+    {
+        std::string_view path;
+        int num;
+    };
+    struct Cmd
+    {
+        std::variant<std::monostate, SubCmd> sub;
+        std::string_view first;
+        std::string_view second;
+        int count;
+    };
+
+    constexpr auto parser = col::Cmd{"cmd", "async test"}
+        .add(col::SubCmd<SubCmd>{"sub", "subcommand"}
+            .add(col::Arg<std::string_view>{"path", "path"}.set_value_parser(slow_parser))
+            .add(col::Arg<int>{"num", "num"}))
+        .add(col::Arg<std::string_view>{"first", "first"}.set_value_parser(slow_parser))
+        .add(col::Arg<std::string_view>{"second", "second"}.set_value_parser(slow_parser).set_default_value("default"))
+        .add(col::Arg<int>{"count", "count"});
+
+    // `parse_async` に範囲 `R` を渡せるか。
+    template <class R>
+    concept parse_async_accepts = requires (R&& r) {
+        parser.parse_async<Cmd>(std::forward<R>(r));
+    };
+    // 要素を所有する範囲は、タスクの完了前に破棄されうる右辺値としては渡せない
+    static_assert(parse_async_accepts<std::vector<std::string>&>);
+    static_assert(parse_async_accepts<const std::array<const char*, 2ZU>&>);
+    static_assert(parse_async_accepts<std::span<const char* const>>);
+    static_assert(!parse_async_accepts<std::vector<std::string>>);
+
+    // カウンタを初期化し、 `overlap` 個のパーサーが同時に実行されるのを待つようにして `parse_async` の完了を待つ。
+    template <std::size_t N>
+    auto parse_async_with_overlap(const std::array<const char*, N>& argv, std::size_t overlap = 1ZU)
+    {
+        parsers.reset(overlap);
+        return col::sync_wait(parser.parse_async<Cmd>(argv));
+    }
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+
+    // 遅いパーサーは同時に実行される
+    {
+        const auto res = parse_async_with_overlap(std::array{ "--first", "ok1", "--count", "3", "--second", "ok2", "sub", "--path", "ok3", "--num", "4" }, 3ZU);
+        if( !res.has_value() || res->first != "ok1" || res->second != "ok2" || res->count != 3 )
+        {
+            std::fputs("concurrent: unexpected result\n", stderr);
+            ok = false;
+        }
+        else if( const auto* sub = std::get_if<SubCmd>(&res->sub); sub == nullptr || sub->path != "ok3" || sub->num != 4 )
+        {
+            std::fputs("concurrent: unexpected subcommand\n", stderr);
+            ok = false;
+        }
+        if( parsers.max_running() < 3ZU )
+        {
+            std::fputs("concurrent: parsers did not overlap\n", stderr);
+            ok = false;
+        }
+    }
+
+    // 指定されなかったオプションはデフォルト値で埋められる
+    {
+        const auto res = parse_async_with_overlap(std::array{ "--first", "ok", "--count", "1" });
+        if( !res.has_value() || res->second != "default" || res->sub.index() != 0ZU )
+        {
+            std::fputs("default: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    // 非同期のパーサーの失敗は `ValueParserError` になる
+    {
+        const auto res = parse_async_with_overlap(std::array{ "--first", "ng", "--count", "1" });
+        if( res.has_value() || res.error().kind() != col::ParseErrorKind::ValueParserError )
+        {
+            std::fputs("parser failure: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    // 親のコマンドとサブコマンドのパーサーがともに失敗した場合は、親のコマンドのエラーになる
+    {
+        const auto res = parse_async_with_overlap(std::array{ "--first", "ng1", "--count", "1", "sub", "--path", "ng2", "--num", "1" }, 2ZU);
+        const auto detail = res.has_value() ? std::nullopt : std::optional{ parser.explain(res.error()) };
+        const auto* err = detail.has_value() ? std::get_if<col::ValueParserError>(&*detail) : nullptr;
+        if( err == nullptr || err->name != "first" || err->arg != "ng1" )
+        {
+            std::fputs("error order: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    // サブコマンドのパーサーのエラーも、ルートのコマンドから詳細を復元できる
+    {
+        const auto res = parse_async_with_overlap(std::array{ "--count", "1", "sub", "--path", "ng", "--num", "1" });
+        const auto detail = res.has_value() ? std::nullopt : std::optional{ parser.explain(res.error()) };
+        const auto* err = detail.has_value() ? std::get_if<col::ValueParserError>(&*detail) : nullptr;
+        if( err == nullptr || err->name != "path" || err->arg != "ng" )
+        {
+            std::fputs("subcommand error: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    // 走査中のエラーは、パーサーを開始せずに返る
+    {
+        const auto res = parse_async_with_overlap(std::array{ "--count", "1", "--first" });
+        if( res.has_value() || res.error().kind() != col::ParseErrorKind::MissingOptionValue || parsers.started() != 0ZU )
+        {
+            std::fputs("missing value: unexpected result\n", stderr);
+            ok = false;
+        }
+        const auto dup = parse_async_with_overlap(std::array{ "--first", "ok", "--first", "ok" });
+        if( dup.has_value() || dup.error().kind() != col::ParseErrorKind::DuplicateOption )
+        {
+            std::fputs("duplicate: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    // 非同期のパーサーを持つコマンドも `parse` で 1 つずつパースできる。
+    // パーサーは 1 つずつ実行されるため、他のパーサーと同時に実行されるのを待たないようにする
+    {
+        const std::array argv{ "--first", "ok1", "--count", "2" };
+        parsers.reset(1ZU);
+        const auto res = parser.parse<Cmd>(argv);
+        if( !res.has_value() || res->first != "ok1" || res->second != "default" || res->count != 2 )
+        {
+            std::fputs("parse: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
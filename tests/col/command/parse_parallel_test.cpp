@@ -0,0 +1,139 @@
+#include "overlap.h"
+
+#include <col/command.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+
+namespace {
+
+    // 同時に実行された変換とデフォルト値の生成を数える。
+    col::test::OverlapCounter jobs{};
+
+    // 他の変換と同時に実行されるまで待つ。
+    void wait_for_overlap()
+    {
+        jobs.enter();
+        jobs.wait();
+        jobs.leave();
+    }
+
+    // 他の変換と同時に実行されるのを待ってから、 `"ok"` で始まる文字列だけを受け付ける。
+    constexpr auto slow_parser = [](const char* str) static -> std::optional<std::string_view>
+        {
+            wait_for_overlap();
+            const std::string_view s{ str };
+            if( s.starts_with("ok") )
+            {
+                return s;
+            }
+            return std::nullopt;
+        };
+
+    struct SubCmd
+    {
+        std::string_view path;
+        int num;
+    };
+    struct Cmd
+    {
+        std::variant<std::monostate, SubCmd> sub;
+        std::string_view first;
+        std::string_view second;
+        int count;
+        bool verbose;
+    };
+
+    constexpr auto parser = col::Cmd{"cmd", "parallel test"}
+        .add(col::SubCmd<SubCmd>{"sub", "subcommand"}
+            .add(col::Arg<std::string_view>{"path", "path"}.set_value_parser(slow_parser))
+            .add(col::Arg<int>{"num", "num"}))
+        .add(col::Arg<std::string_view>{"first", "first"}.set_value_parser(slow_parser))
+        .add(col::Arg<std::string_view>{"second", "second"}.set_value_parser(slow_parser))
+        .add(col::Arg<int>{"count", "count"}.set_default_value([]() static
+            {
+                wait_for_overlap();
+                return 7;
+            }))
+        .add(col::Arg{"verbose", "verbose"})
+        .set_parallelism(4ZU);
+
+    // カウンタを初期化し、 2 つの処理が同時に実行されるのを待つようにして `parse` する。
+    template <std::size_t N>
+    auto parse_with_overlap(const std::array<const char*, N>& argv)
+    {
+        jobs.reset(2ZU);
+        return parser.parse<Cmd>(argv);
+    }
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+
+    // 遅い変換とデフォルト値の生成は並行に行われる
+    {
+        const auto res = parse_with_overlap(std::array{ "--verbose", "--second", "ok2", "--first", "ok1", "sub", "--path", "ok3", "--num", "4" });
+        if( !res.has_value() || res->first != "ok1" || res->second != "ok2" || res->count != 7 || !res->verbose )
+        {
+            std::fputs("parallel: unexpected result\n", stderr);
+            ok = false;
+        }
+        else if( const auto* sub = std::get_if<SubCmd>(&res->sub); sub == nullptr || sub->path != "ok3" || sub->num != 4 )
+        {
+            std::fputs("parallel: unexpected subcommand\n", stderr);
+            ok = false;
+        }
+        if( jobs.max_running() < 2ZU )
+        {
+            std::fputs("parallel: conversions did not overlap\n", stderr);
+            ok = false;
+        }
+    }
+
+    // 複数の変換が失敗した場合は、スレッドの実行順によらず定義順で最初のエラーになる
+    for( std::size_t i = 0ZU; i < 4ZU; ++i )
+    {
+        const auto res = parse_with_overlap(std::array{ "--second", "ng2", "--first", "ng1", "--count", "1" });
+        const auto detail = res.has_value() ? std::nullopt : std::optional{ parser.explain(res.error()) };
+        const auto* err = detail.has_value() ? std::get_if<col::ValueParserError>(&*detail) : nullptr;
+        if( err == nullptr || err->name != "first" || err->arg != "ng1" )
+        {
+            std::fputs("error order: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    // サブコマンドの変換のエラーも、ルートのコマンドから詳細を復元できる
+    {
+        const auto res = parse_with_overlap(std::array{ "--first", "ok1", "sub", "--path", "ng", "--num", "1" });
+        const auto detail = res.has_value() ? std::nullopt : std::optional{ parser.explain(res.error()) };
+        const auto* err = detail.has_value() ? std::get_if<col::ValueParserError>(&*detail) : nullptr;
+        if( err == nullptr || err->name != "path" || err->arg != "ng" )
+        {
+            std::fputs("subcommand error: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    // 走査中のエラーは、変換を始める前に返る。
+    // そのため、 1 つずつ変換するときは最初の値の `ValueParserError` になる引数でも `DuplicateOption` になる
+    {
+        const auto res = parse_with_overlap(std::array{ "--first", "ng", "--first", "ok" });
+        if( res.has_value() || res.error().kind() != col::ParseErrorKind::DuplicateOption || jobs.started() != 0ZU )
+        {
+            std::fputs("duplicate: unexpected result\n", stderr);
+            ok = false;
+        }
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
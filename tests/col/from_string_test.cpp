@@ -0,0 +1,145 @@
+#include <col/from_string.h>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <expected>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+
+namespace {
+
+    // 高速化前の `col::integral_from_string` と同じく、 `std::from_chars` だけで変換する。
+    template <class T>
+    std::expected<T, std::from_chars_result> reference_from_string(std::string_view str) noexcept
+    {
+        int base = 10;
+        if( str.starts_with("0x") )
+        {
+            str.remove_prefix(2ZU);
+            base = 16;
+        }
+        T value{};
+        const auto res = std::from_chars(str.cbegin(), str.cend(), value, base);
+        if( res.ptr == str.cend() && res.ec == std::errc{} )
+        {
+            return value;
+        }
+        return std::unexpected{ res };
+    }
+
+    // `col::integral_from_string<T>` と `reference_from_string<T>` の結果が一致するかを調べる。
+    template <class T>
+    bool expect_same(const char* type, const std::string& token)
+    {
+        const auto actual = col::integral_from_string<T>(token);
+        const auto expected = reference_from_string<T>(token);
+        const bool same = actual.has_value() == expected.has_value() && (
+            actual.has_value()
+                ? *actual == *expected
+                : actual.error().ptr == expected.error().ptr && actual.error().ec == expected.error().ec
+        );
+        if( !same )
+        {
+            std::fprintf(stderr, "%s: mismatch for `%s`\n", type, token.c_str());
+        }
+        return same;
+    }
+
+    // 8 〜 20 桁前後の数値を中心に、符号・接頭辞・不正な文字・桁あふれを混ぜたトークンを作る。
+    std::string make_token(std::mt19937_64& rng)
+    {
+        constexpr std::string_view decimal = "0123456789";
+        constexpr std::string_view hex = "0123456789abcdefABCDEF";
+        constexpr std::string_view noise = "-+ xg/:@`G\x7f";
+
+        const bool is_hex = rng() % 3U == 0U;
+        std::string token = is_hex ? "0x" : "";
+        if( rng() % 4U == 0U )
+        {
+            token += '-';
+        }
+        const std::string_view digits = is_hex ? hex : decimal;
+        const auto length = static_cast<std::size_t>(rng() % 24U);
+        for( std::size_t i = 0ZU; i < length; ++i )
+        {
+            token += digits[rng() % digits.size()];
+        }
+        if( !token.empty() && rng() % 8U == 0U )
+        {
+            token[rng() % token.size()] = noise[rng() % noise.size()];
+        }
+        return token;
+    }
+
+} // namespace
+
+// `make runtime_test` では SWAR の変換を、 `make simd_test` では SSE4.1 の変換を検証する。
+int main()
+{
+    bool ok = true;
+
+    // 境界値
+    for( const char* token : {
+        "12345678", "-12345678", "0x12345678", "0xdeadBEEF", "0xffffffffffffffff", "0x10000000000000000",
+        "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+        "9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+        "18446744073709551615", "18446744073709551616", "99999999999999999999", "00000000000000000001",
+        "1234567812345678", "123456781234567x", "0x123456781234567g", "0x-12345678", "+12345678",
+    } )
+    {
+        ok &= expect_same<std::int8_t>("int8", token);
+        ok &= expect_same<std::int32_t>("int32", token);
+        ok &= expect_same<std::uint32_t>("uint32", token);
+        ok &= expect_same<std::int64_t>("int64", token);
+        ok &= expect_same<std::uint64_t>("uint64", token);
+    }
+
+    // ランダムなトークン
+    std::mt19937_64 rng{ 20260101U };
+    for( std::size_t i = 0ZU; i < 200000ZU; ++i )
+    {
+        const auto token = make_token(rng);
+        ok &= expect_same<std::int16_t>("int16", token);
+        ok &= expect_same<std::int32_t>("int32", token);
+        ok &= expect_same<std::uint32_t>("uint32", token);
+        ok &= expect_same<std::int64_t>("int64", token);
+        ok &= expect_same<std::uint64_t>("uint64", token);
+    }
+
+    // 浮動小数点数の列。 `std::from_chars` が定数式で使えない環境があるため、実行時に確かめる
+    {
+        std::vector<double> values{};
+        const auto res = col::number_list_from_string<double>("1.5;2", ';', std::back_inserter(values));
+        if( !res.has_value() || values != std::vector{ 1.5, 2.0 } )
+        {
+            std::fputs("double list: unexpected result\n", stderr);
+            ok = false;
+        }
+
+        std::vector<double> empty{};
+        const auto empty_res = col::number_list_from_string<double>("", ',', std::back_inserter(empty));
+        if( !empty_res.has_value() || !empty.empty() )
+        {
+            std::fputs("double list: empty string is not an empty list\n", stderr);
+            ok = false;
+        }
+
+        const auto failed = col::number_list_from_string<double>("1.5;x", ';', std::back_inserter(values));
+        if( failed.has_value() || failed.error().element != "x" )
+        {
+            std::fputs("double list: unexpected failure element\n", stderr);
+            ok = false;
+        }
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
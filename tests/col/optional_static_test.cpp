@@ -1,4 +1,14 @@
 #include <col/optional.h>
+#include <col/nonnull.h>
+#include <col/nonzero.h>
+
+#include <cstdint>
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 
 struct MyType
@@ -19,16 +29,102 @@ constexpr bool operator==(const MyType& x, int y) {
     return x.m_i == y;
 }
 
+enum class MyEnum : unsigned char
+{
+    A,
+    B,
+    C,
+};
+
 namespace col {
     template <>
     struct sentinel_nullable_traits<MyType>
     {
         static constexpr int sentinel_value = 0;
     };
+
+    template <>
+    struct niche_traits<MyEnum> : enum_niche_traits<MyEnum, 0xFFU> {};
+}
+
+// 非トリビアルなデストラクタを持つが、自身のアドレスに依存しない型
+struct Handle
+{
+    int* m_ptr;
+    constexpr Handle(int* ptr) noexcept : m_ptr{ptr}{}
+    constexpr Handle(Handle&& rhs) noexcept : m_ptr{std::exchange(rhs.m_ptr, nullptr)}{}
+    constexpr Handle& operator=(Handle&& rhs) noexcept
+    {
+        m_ptr = std::exchange(rhs.m_ptr, nullptr);
+        return *this;
+    }
+    constexpr ~Handle()
+    {
+        if( m_ptr != nullptr )
+        {
+            ++*m_ptr;
+        }
+    }
+};
+
+namespace col {
+    template <>
+    struct is_trivially_relocatable<Handle> : std::true_type {};
 }
 
 namespace {
 
+    // `T` がトリビアルにコピー可能・破棄可能であれば、 `col::optional<T>` も同様である
+    template <class T>
+    constexpr bool preserves_triviality =
+        std::is_trivially_copyable_v<T> == std::is_trivially_copyable_v<col::optional<T>> &&
+        std::is_trivially_destructible_v<T> == std::is_trivially_destructible_v<col::optional<T>> &&
+        std::is_trivially_copyable_v<T> == std::is_trivially_copyable_v<col::optional<T, false>> &&
+        std::is_trivially_destructible_v<T> == std::is_trivially_destructible_v<col::optional<T, false>> &&
+        std::is_trivially_copy_constructible_v<T> == std::is_trivially_copy_constructible_v<col::optional<T>> &&
+        std::is_trivially_move_constructible_v<T> == std::is_trivially_move_constructible_v<col::optional<T>> &&
+        std::is_trivially_copy_assignable_v<T> == std::is_trivially_copy_assignable_v<col::optional<T>> &&
+        std::is_trivially_move_assignable_v<T> == std::is_trivially_move_assignable_v<col::optional<T>>;
+    static_assert(preserves_triviality<int>);
+    static_assert(preserves_triviality<double>);
+    static_assert(preserves_triviality<bool>);
+    static_assert(preserves_triviality<int*>);
+    static_assert(preserves_triviality<MyType>);
+    static_assert(preserves_triviality<MyEnum>);
+    static_assert(preserves_triviality<col::NonZeroU32>);
+    static_assert(preserves_triviality<col::NonNull<int>>);
+    static_assert(preserves_triviality<std::optional<int>>);
+    static_assert(preserves_triviality<Handle>);
+    static_assert(std::is_trivially_copyable_v<col::optional<int&>>);
+    static_assert(std::is_trivially_destructible_v<col::optional<int&>>);
+
+    // トリビアルに再配置可能であることは、 `T` が指定したものを `col::optional<T>` も引き継ぐ
+    static_assert(col::is_trivially_relocatable_v<col::optional<int>>);
+    static_assert(col::is_trivially_relocatable_v<col::optional<double>>);
+    static_assert(col::is_trivially_relocatable_v<const col::optional<int*>>);
+    static_assert(col::is_trivially_relocatable_v<col::optional<Handle>>);
+    static_assert(col::is_trivially_relocatable_v<col::optional<Handle, false>>);
+    static_assert(col::is_trivially_relocatable_v<col::optional<Handle&>>);
+    static_assert(!col::is_trivially_relocatable_v<col::optional<std::optional<Handle>>>);
+
+    // 定数式では `uninitialized_relocate` はムーブと破棄で再配置する
+    consteval bool test_relocate() {
+        int destroyed = 0;
+        std::allocator<col::optional<Handle>> alloc{};
+        auto* const src = alloc.allocate(3ZU);
+        auto* const dst = alloc.allocate(3ZU);
+        std::construct_at(src + 0, Handle{ &destroyed });
+        std::construct_at(src + 1);
+        std::construct_at(src + 2, Handle{ &destroyed });
+        const auto* const end = col::uninitialized_relocate(src, src + 3, dst);
+        const bool ok = end == dst + 3 && destroyed == 0 && dst[0].has_value() && !dst[1].has_value() && dst[2].value().m_ptr == &destroyed;
+        std::destroy(dst, dst + 3);
+        alloc.deallocate(src, 3ZU);
+        alloc.deallocate(dst, 3ZU);
+        return ok && destroyed == 2;
+    }
+    static_assert(test_relocate());
+
     static_assert(std::same_as<col::optional<int>::value_type, int>);
     static_assert(std::same_as<col::optional<int*>::value_type, int>);
     static_assert(std::same_as<col::optional<MyType>::value_type, MyType>);
@@ -38,6 +134,45 @@ namespace {
     static_assert(sizeof(col::optional<MyType>) == sizeof(MyType));
     static_assert(sizeof(col::optional<MyType, false>) == sizeof(std::optional<MyType>));
 
+    // `NonZero` と `NonNull` は有効値が取り得ない値を番兵値とし、無効値のための領域を持たない
+    static_assert(sizeof(col::optional<col::NonZeroU8>) == sizeof(col::NonZeroU8));
+    static_assert(sizeof(col::optional<col::NonZeroU32>) == sizeof(col::NonZeroU32));
+    static_assert(sizeof(col::optional<col::NonZeroI64>) == sizeof(col::NonZeroI64));
+    static_assert(sizeof(col::optional<col::NonZeroU64>) == sizeof(std::uint64_t));
+    static_assert(sizeof(col::optional<col::NonNull<int>>) == sizeof(int*));
+    static_assert(sizeof(col::NonZeroU32::make_nonzero(1)) == sizeof(std::uint32_t));
+
+    // 値として取り得ないビット列を無効値とする型も、無効値のための領域を持たない
+    static_assert(sizeof(col::optional<double>) == sizeof(double));
+    static_assert(sizeof(col::optional<float>) == sizeof(float));
+    static_assert(sizeof(col::optional<bool>) == sizeof(bool));
+    static_assert(sizeof(col::optional<MyEnum>) == sizeof(MyEnum));
+    static_assert(sizeof(col::optional<double, false>) == sizeof(std::optional<double>));
+    static_assert(std::is_trivially_copyable_v<col::optional<double>>);
+    static_assert(std::is_trivially_copyable_v<col::optional<bool>>);
+
+    // 参照の `optional` はポインタ 1 つ分の大きさで、一時オブジェクトからは構築できない
+    static_assert(sizeof(col::optional<int&>) == sizeof(int*));
+    static_assert(sizeof(col::optional<const MyType&>) == sizeof(MyType*));
+    static_assert(std::is_trivially_copyable_v<col::optional<int&>>);
+    static_assert(std::is_constructible_v<col::optional<const int&>, int&>);
+    static_assert(!std::is_constructible_v<col::optional<const int&>, int>);
+    static_assert(!std::is_constructible_v<col::optional<int&>, const int&>);
+    static_assert(std::same_as<col::optional<int&>::value_type, int>);
+
+    // 変換代入は `T` への代入と構築が例外を送出しなければ `noexcept`
+    static_assert(std::is_nothrow_assignable_v<col::optional<const int*, true>&, const col::optional<int*>&>);
+    static_assert(std::is_nothrow_assignable_v<col::optional<const int*, true>&, col::optional<int*>&&>);
+
+    // 参照の `optional` の例外仕様は、参照先の型と渡した関数から決まる
+    static_assert(noexcept(std::declval<const col::optional<int&>&>().value()));
+    static_assert(noexcept(std::declval<const col::optional<int&>&>().value_or(0)));
+    static_assert(noexcept(std::declval<const col::optional<int&>&>().transform([](int& v) noexcept { return v; })));
+    static_assert(!noexcept(std::declval<const col::optional<int&>&>().transform([](int& v) { return v; })));
+    static_assert(noexcept(std::declval<const col::optional<int&>&>().and_then([](int& v) noexcept { return col::optional<int&>{ v }; })));
+    static_assert(noexcept(std::declval<const col::optional<int&>&>().or_else([]() noexcept { return col::optional<int&>{}; })));
+    static_assert(!noexcept(std::declval<const col::optional<int&>&>().or_else([]() { return col::optional<int&>{}; })));
+
     consteval bool test_optimized_ptr() {
         int i = 1;
         col::optional opt{&i};
@@ -81,6 +216,130 @@ namespace {
     }
     static_assert(test_optimized_mytype());
 
+    consteval bool test_optimized_nonzero() {
+        const auto zero = col::NonZeroU32::make_nonzero(0);
+        const auto one = col::NonZeroU32::make_nonzero(1);
+        if( zero.has_value() || !one.has_value() || one->get() != 1 )
+        {
+            return false;
+        }
+        const auto res = one
+            .and_then([](col::NonZeroU32 v){ return col::NonZeroU32::make_nonzero(v * 2U); })
+            .transform([](col::NonZeroU32 v){ return v.get() + 1U; });
+        return res.has_value() && *res == 3U && zero.value_or(col::NonZeroU32::make_nonzero_unchecked(5)) == 5U;
+    }
+    static_assert(test_optimized_nonzero());
+
+    consteval bool test_optimized_nonnull() {
+        int i = 1;
+        col::optional<col::NonNull<int>> opt{};
+        if( opt.has_value() )
+        {
+            return false;
+        }
+        opt = col::NonNull{ i };
+        if( !opt.has_value() || (*opt).get() != &i )
+        {
+            return false;
+        }
+        opt.reset();
+        return !opt.has_value();
+    }
+    static_assert(test_optimized_nonnull());
+
+    consteval bool test_optimized_double() {
+        col::optional<double> opt{};
+        if( opt.has_value() )
+        {
+            return false;
+        }
+        opt = 1.5;
+        if( !opt.has_value() || *opt != 1.5 )
+        {
+            return false;
+        }
+        col::optional<double> nan{ std::numeric_limits<double>::quiet_NaN() };
+        if( !nan.has_value() )
+        {
+            return false;
+        }
+        opt.swap(nan);
+        nan.reset();
+        return opt.has_value() && !nan.has_value() && nan.value_or(2.0) == 2.0;
+    }
+    static_assert(test_optimized_double());
+
+    consteval bool test_optimized_enum() {
+        col::optional<MyEnum> opt{};
+        if( opt.has_value() )
+        {
+            return false;
+        }
+        opt.emplace(MyEnum::C);
+        const auto res = opt.transform([](MyEnum e){ return std::to_underlying(e); });
+        return res.has_value() && *res == 2U;
+    }
+    static_assert(test_optimized_enum());
+
+    consteval bool test_reference() {
+        int i = 1;
+        int j = 2;
+        col::optional<int&> opt{};
+        if( opt.has_value() || opt.value_or(3) != 3 )
+        {
+            return false;
+        }
+        opt = col::optional<int&>{ i };
+        *opt = 10;
+        if( i != 10 )
+        {
+            return false;
+        }
+
+        // 代入は参照先を付け替え、参照先の値は変更しない
+        opt.emplace(j);
+        if( i != 10 || &*opt != &j )
+        {
+            return false;
+        }
+
+        // 左辺値参照を返す関数の `transform` は参照先をコピーしない
+        struct Pair
+        {
+            int first;
+            int second;
+        };
+        Pair p{ 1, 2 };
+        const col::optional<Pair&> pair{ p };
+        const auto second = pair.transform([](Pair& x) -> int& { return x.second; });
+        static_assert(std::same_as<std::remove_cvref_t<decltype(second)>, col::optional<int&>>);
+        *second = 20;
+        const auto sum = pair.transform([](const Pair& x){ return x.first + x.second; });
+
+        const col::optional<const int&> cref{ opt };
+        const auto half = cref.and_then([](const int& v){ return v % 2 == 0 ? col::optional<const int&>{ v } : col::optional<const int&>{}; });
+        return p.second == 20 && sum.has_value() && *sum == 21 && half.has_value() && &*half == &j;
+    }
+    static_assert(test_reference());
+
+#if __has_builtin(__builtin_is_within_lifetime)
+    consteval bool test_optimized_bool() {
+        col::optional<bool> opt{};
+        if( opt.has_value() )
+        {
+            return false;
+        }
+        opt = false;
+        if( !opt.has_value() || *opt )
+        {
+            return false;
+        }
+        opt.reset();
+        return !opt.has_value();
+    }
+    static_assert(test_optimized_bool());
+#endif
+
 
     consteval bool test_non_optimized() {
         col::optional opt{10};
@@ -0,0 +1,165 @@
+#include <col/optional_vector.h>
+
+#include <cstddef>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+    static_assert(std::random_access_iterator<col::optional_vector<double>::iterator>);
+    static_assert(std::random_access_iterator<col::optional_vector<double>::const_iterator>);
+    static_assert(std::ranges::random_access_range<col::optional_vector<double>>);
+    static_assert(std::ranges::sized_range<const col::optional_vector<double>>);
+
+    // 要素を取り出した値は、コンテナを指すプロキシではなく値をコピーした `col::optional`
+    static_assert(std::same_as<std::ranges::range_value_t<col::optional_vector<double>>, col::optional<double>>);
+    static_assert(std::same_as<std::ranges::range_reference_t<col::optional_vector<double>>, col::optional_vector<double>::reference>);
+
+    // 要素のプロキシの例外仕様は、要素の型と渡した関数から決まる
+    static_assert(noexcept(std::declval<const col::optional_vector<double>::reference&>().value()));
+    static_assert(noexcept(std::declval<const col::optional_vector<double>::const_reference&>().value_or(0.0)));
+    static_assert(noexcept(std::declval<const col::optional_vector<double>::reference&>().transform([](double v) noexcept { return v; })));
+    static_assert(!noexcept(std::declval<const col::optional_vector<double>::reference&>().transform([](double v) { return v; })));
+    static_assert(noexcept(std::declval<const col::optional_vector<double>::const_reference&>().and_then([](double v) noexcept { return col::optional<double>{ v }; })));
+    static_assert(!noexcept(std::declval<const col::optional_vector<double>::const_reference&>().and_then([](double v) { return col::optional<double>{ v }; })));
+
+    consteval bool test_push_and_access() {
+        col::optional_vector<double> vec{ 1.0, std::nullopt, 3.0 };
+        vec.push_back(std::nullopt);
+        vec.emplace_back(5.0);
+        if( vec.size() != 5ZU || vec.count_engaged() != 3ZU )
+        {
+            return false;
+        }
+        if( !vec.has_value(0ZU) || vec.has_value(1ZU) || vec[1ZU] != std::nullopt || *vec[2ZU] != 3.0 )
+        {
+            return false;
+        }
+
+        vec[1ZU] = 2.0;
+        vec[2ZU] = std::nullopt;
+        const col::optional<double> copied = vec[1ZU];
+        return copied.has_value() && *copied == 2.0
+            && !vec[2ZU].has_value()
+            && vec[2ZU].value_or(-1.0) == -1.0
+            && vec.count_engaged() == 3ZU;
+    }
+    static_assert(test_push_and_access());
+
+    consteval bool test_assign_element() {
+        col::optional_vector<int> vec{ 1, std::nullopt, 3 };
+
+        // 有効値を持つ要素を、無効値の要素に代入する
+        vec[1ZU] = vec[0ZU];
+        if( !vec.has_value(1ZU) || *vec[1ZU] != 1 || *vec[0ZU] != 1 )
+        {
+            return false;
+        }
+
+        // 無効値の要素を、有効値を持つ要素に代入する
+        vec[2ZU] = std::nullopt;
+        vec[0ZU] = vec[2ZU];
+        if( vec.has_value(0ZU) || vec.has_value(2ZU) || vec.count_engaged() != 1ZU )
+        {
+            return false;
+        }
+
+        // 読み取り専用のプロキシからも代入でき、イテレータを介しても同じ
+        const auto& cvec = vec;
+        vec[0ZU] = cvec[1ZU];
+        *vec.begin() = 5;
+        *(vec.begin() + 2) = *(vec.begin() + 1);
+
+        // 取り出した値は要素のコピーで、元の要素を書き換えても変わらない
+        std::ranges::range_value_t<col::optional_vector<int>> copied = *vec.begin();
+        vec[0ZU] = std::nullopt;
+        return copied.has_value() && *copied == 5
+            && *vec[1ZU] == 1 && *vec[2ZU] == 1
+            && vec.count_engaged() == 2ZU;
+    }
+    static_assert(test_assign_element());
+
+    consteval bool test_bulk() {
+        col::optional_vector<int> vec{};
+        for( int i = 0; i < 150; ++i )
+        {
+            if( i % 3 == 0 )
+            {
+                vec.push_back(std::nullopt);
+            }
+            else
+            {
+                vec.push_back(i);
+            }
+        }
+        if( vec.count_engaged() != 100ZU )
+        {
+            return false;
+        }
+
+        // 要素数を減らしても、範囲外になったビットは数えない
+        vec.resize(100ZU);
+        vec.resize(130ZU);
+        if( vec.count_engaged() != 66ZU || vec.has_value(120ZU) )
+        {
+            return false;
+        }
+
+        vec.fill_nullopt();
+        return vec.count_engaged() == 0ZU && vec.size() == 130ZU;
+    }
+    static_assert(test_bulk());
+
+    consteval bool test_monadic() {
+        col::optional_vector<int> vec{};
+        for( int i = 0; i < 130; ++i )
+        {
+            if( i == 70 )
+            {
+                vec.push_back(std::nullopt);
+            }
+            else
+            {
+                vec.push_back(i);
+            }
+        }
+
+        const auto doubled = vec.transform([](int v){ return static_cast<double>(v) * 2.0; });
+        static_assert(std::same_as<std::remove_cvref_t<decltype(doubled)>, col::optional_vector<double>>);
+        if( doubled.count_engaged() != 129ZU || doubled.has_value(70ZU) || *doubled[129ZU] != 258.0 )
+        {
+            return false;
+        }
+
+        const auto even = vec.and_then([](int v){ return v % 2 == 0 ? col::optional<int>{ v / 2 } : col::optional<int>{}; });
+        if( even.count_engaged() != 64ZU || even.has_value(1ZU) || *even[128ZU] != 64 )
+        {
+            return false;
+        }
+
+        // 各要素のプロキシも `col::optional` と同じモナド操作を持つ
+        const auto r = vec[3ZU].transform([](int v){ return v + 1; });
+        return r.has_value() && *r == 4 && !vec[70ZU].and_then([](int v){ return col::optional<int>{ v }; }).has_value();
+    }
+    static_assert(test_monadic());
+
+    consteval bool test_ranges() {
+        const col::optional_vector<int> vec{ 1, std::nullopt, 3, std::nullopt, 5 };
+        auto engaged = vec
+            | std::views::filter([](auto e){ return e.has_value(); })
+            | std::views::transform([](auto e){ return *e; });
+        int sum = 0;
+        for( const int v : engaged )
+        {
+            sum += v;
+        }
+        return sum == 9 && std::ranges::count_if(vec, [](auto e){ return e == std::nullopt; }) == 2;
+    }
+    static_assert(test_ranges());
+
+} // namespace
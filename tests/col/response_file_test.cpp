@@ -0,0 +1,125 @@
+#include <col/command.h>
+#include <col/response_file.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+
+namespace {
+
+    // 一時ファイルに `content` を書き込み、そのパスを返す。
+    std::string write_temp_file(std::string_view content)
+    {
+        std::string path = "/tmp/col_response_file_XXXXXX";
+        const int fd = ::mkstemp(path.data());
+        if( fd < 0 || ::write(fd, content.data(), content.size()) != static_cast<::ssize_t>(content.size()) )
+        {
+            std::fputs("cannot create a temporary file\n", stderr);
+            std::exit(EXIT_FAILURE);
+        }
+        ::close(fd);
+        return path;
+    }
+
+    // `args` を展開した結果が `expected` と一致するかを調べる。
+    bool expect_args(const char* name, const std::vector<const char*>& args, col::ResponseFileQuoting quoting, std::initializer_list<std::string_view> expected)
+    {
+        col::ResponseFileArgs expanded{ args.begin(), args.end(), quoting };
+        std::vector<std::string_view> actual{};
+        for( const char* arg : expanded )
+        {
+            actual.emplace_back(arg);
+        }
+        if( !std::ranges::equal(actual, expected) )
+        {
+            std::fprintf(stderr, "%s: unexpected arguments:", name);
+            for( const auto& arg : actual )
+            {
+                std::fprintf(stderr, " [%.*s]", static_cast<int>(arg.size()), arg.data());
+            }
+            std::fputc('\n', stderr);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+
+    // GCC 形式の引用符とエスケープ、入れ子のレスポンスファイル、開けないファイル
+    const auto nested = write_temp_file("nested\t'single quoted'\n");
+    const auto gnu = write_temp_file("a \"b c\" d\\ e 'f\"g' @" + nested + " \"\"\n@/nonexistent/file tail");
+    const auto gnu_arg = "@" + gnu;
+    ok &= expect_args("gnu", { "pre", gnu_arg.c_str(), "post" }, col::ResponseFileQuoting::Gnu,
+        { "pre", "a", "b c", "d e", "f\"g", "nested", "single quoted", "", "@/nonexistent/file", "tail", "post" });
+
+    // MSVC 形式の引用符とバックスラッシュ
+    const auto msvc = write_temp_file(R"(a\\\"b "c d" "e""f" g\\h "x\\")");
+    const auto msvc_arg = "@" + msvc;
+    ok &= expect_args("msvc", { msvc_arg.c_str() }, col::ResponseFileQuoting::Msvc,
+        { R"(a\"b)", "c d", R"(e"f)", R"(g\\h)", R"(x\)" });
+
+    // 自分自身を参照するレスポンスファイルは入れ子の上限で展開を止める
+    std::string self = "/tmp/col_response_file_XXXXXX";
+    const int fd = ::mkstemp(self.data());
+    const auto self_content = "x @" + self;
+    static_cast<void>(::write(fd, self_content.data(), self_content.size()));
+    ::close(fd);
+    const auto self_arg = "@" + self;
+    {
+        const std::array self_argv{ self_arg.c_str() };
+        col::ResponseFileArgs expanded{ self_argv.begin(), self_argv.end() };
+        std::size_t count = 0ZU;
+        for( [[maybe_unused]] const char* arg : expanded )
+        {
+            ++count;
+        }
+        if( count != col::MaxResponseFileDepth + 1ZU )
+        {
+            std::fprintf(stderr, "self reference: %zu argument(s)\n", count);
+            ok = false;
+        }
+    }
+
+    // イテレータと番兵を Cmd::parse にそのまま渡せる
+    struct Cmd
+    {
+        bool verbose;
+        int count;
+        std::string name;
+    };
+    constexpr auto parser = col::Cmd{"cmd", "response file test"}
+        .add(col::Arg{"verbose", "verbose"})
+        .add(col::Arg<int>{"count", "count"})
+        .add(col::Arg<std::string>{"name", "name"});
+    const auto options = write_temp_file("--count 42\n--name 'John Doe'\n");
+    const auto options_arg = "@" + options;
+    const std::array argv{ "--verbose", options_arg.c_str() };
+    col::ResponseFileArgs expanded{ argv.begin(), argv.end() };
+    auto iter = expanded.begin();
+    const auto res = parser.parse<Cmd>(iter, expanded.end());
+    if( !res.has_value() || !res->verbose || res->count != 42 || res->name != "John Doe" )
+    {
+        std::fputs("parse: unexpected result\n", stderr);
+        ok = false;
+    }
+
+    for( const auto& path : { nested, gnu, msvc, self, options } )
+    {
+        std::remove(path.c_str());
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}